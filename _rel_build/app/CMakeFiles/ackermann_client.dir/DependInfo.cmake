@@ -0,0 +1,20 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/app/Notifier.cpp" "app/CMakeFiles/ackermann_client.dir/Notifier.cpp.o" "gcc" "app/CMakeFiles/ackermann_client.dir/Notifier.cpp.o.d"
+  "/root/repo/app/SharedClient.cpp" "app/CMakeFiles/ackermann_client.dir/SharedClient.cpp.o" "gcc" "app/CMakeFiles/ackermann_client.dir/SharedClient.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,13 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ackermann_client.dir/Notifier.cpp.o"
+  "CMakeFiles/ackermann_client.dir/Notifier.cpp.o.d"
+  "CMakeFiles/ackermann_client.dir/SharedClient.cpp.o"
+  "CMakeFiles/ackermann_client.dir/SharedClient.cpp.o.d"
+  "libackermann_client.a"
+  "libackermann_client.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ackermann_client.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,35 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/app/Angle.cpp" "app/CMakeFiles/ackermann_core.dir/Angle.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/Angle.cpp.o.d"
+  "/root/repo/app/CommandHistory.cpp" "app/CMakeFiles/ackermann_core.dir/CommandHistory.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/CommandHistory.cpp.o.d"
+  "/root/repo/app/Controller.cpp" "app/CMakeFiles/ackermann_core.dir/Controller.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/Controller.cpp.o.d"
+  "/root/repo/app/Executor.cpp" "app/CMakeFiles/ackermann_core.dir/Executor.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/Executor.cpp.o.d"
+  "/root/repo/app/FleetController.cpp" "app/CMakeFiles/ackermann_core.dir/FleetController.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/FleetController.cpp.o.d"
+  "/root/repo/app/FlightRecorder.cpp" "app/CMakeFiles/ackermann_core.dir/FlightRecorder.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/FlightRecorder.cpp.o.d"
+  "/root/repo/app/Limits.cpp" "app/CMakeFiles/ackermann_core.dir/Limits.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/Limits.cpp.o.d"
+  "/root/repo/app/Model.cpp" "app/CMakeFiles/ackermann_core.dir/Model.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/Model.cpp.o.d"
+  "/root/repo/app/Notifier.cpp" "app/CMakeFiles/ackermann_core.dir/Notifier.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/Notifier.cpp.o.d"
+  "/root/repo/app/PID.cpp" "app/CMakeFiles/ackermann_core.dir/PID.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/PID.cpp.o.d"
+  "/root/repo/app/Realtime.cpp" "app/CMakeFiles/ackermann_core.dir/Realtime.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/Realtime.cpp.o.d"
+  "/root/repo/app/Replay.cpp" "app/CMakeFiles/ackermann_core.dir/Replay.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/Replay.cpp.o.d"
+  "/root/repo/app/SharedClient.cpp" "app/CMakeFiles/ackermann_core.dir/SharedClient.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/SharedClient.cpp.o.d"
+  "/root/repo/app/SharedServer.cpp" "app/CMakeFiles/ackermann_core.dir/SharedServer.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/SharedServer.cpp.o.d"
+  "/root/repo/app/StageProfiler.cpp" "app/CMakeFiles/ackermann_core.dir/StageProfiler.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/StageProfiler.cpp.o.d"
+  "/root/repo/app/TimingStats.cpp" "app/CMakeFiles/ackermann_core.dir/TimingStats.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/TimingStats.cpp.o.d"
+  "/root/repo/app/Trajectory.cpp" "app/CMakeFiles/ackermann_core.dir/Trajectory.cpp.o" "gcc" "app/CMakeFiles/ackermann_core.dir/Trajectory.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,43 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/ackermann_core.dir/Angle.cpp.o"
+  "CMakeFiles/ackermann_core.dir/Angle.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/CommandHistory.cpp.o"
+  "CMakeFiles/ackermann_core.dir/CommandHistory.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/Controller.cpp.o"
+  "CMakeFiles/ackermann_core.dir/Controller.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/Executor.cpp.o"
+  "CMakeFiles/ackermann_core.dir/Executor.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/FleetController.cpp.o"
+  "CMakeFiles/ackermann_core.dir/FleetController.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/FlightRecorder.cpp.o"
+  "CMakeFiles/ackermann_core.dir/FlightRecorder.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/Limits.cpp.o"
+  "CMakeFiles/ackermann_core.dir/Limits.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/Model.cpp.o"
+  "CMakeFiles/ackermann_core.dir/Model.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/Notifier.cpp.o"
+  "CMakeFiles/ackermann_core.dir/Notifier.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/PID.cpp.o"
+  "CMakeFiles/ackermann_core.dir/PID.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/Realtime.cpp.o"
+  "CMakeFiles/ackermann_core.dir/Realtime.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/Replay.cpp.o"
+  "CMakeFiles/ackermann_core.dir/Replay.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/SharedClient.cpp.o"
+  "CMakeFiles/ackermann_core.dir/SharedClient.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/SharedServer.cpp.o"
+  "CMakeFiles/ackermann_core.dir/SharedServer.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/StageProfiler.cpp.o"
+  "CMakeFiles/ackermann_core.dir/StageProfiler.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/TimingStats.cpp.o"
+  "CMakeFiles/ackermann_core.dir/TimingStats.cpp.o.d"
+  "CMakeFiles/ackermann_core.dir/Trajectory.cpp.o"
+  "CMakeFiles/ackermann_core.dir/Trajectory.cpp.o.d"
+  "libackermann_core.a"
+  "libackermann_core.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/ackermann_core.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
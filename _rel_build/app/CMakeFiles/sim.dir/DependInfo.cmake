@@ -0,0 +1,23 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/app/Simulation.cpp" "app/CMakeFiles/sim.dir/Simulation.cpp.o" "gcc" "app/CMakeFiles/sim.dir/Simulation.cpp.o.d"
+  "/root/repo/app/fake/noise.cpp" "app/CMakeFiles/sim.dir/fake/noise.cpp.o" "gcc" "app/CMakeFiles/sim.dir/fake/noise.cpp.o.d"
+  "/root/repo/app/fake/plant.cpp" "app/CMakeFiles/sim.dir/fake/plant.cpp.o" "gcc" "app/CMakeFiles/sim.dir/fake/plant.cpp.o.d"
+  "/root/repo/app/sim.cpp" "app/CMakeFiles/sim.dir/sim.cpp.o" "gcc" "app/CMakeFiles/sim.dir/sim.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel_build/app/CMakeFiles/ackermann_core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/sim.dir/Simulation.cpp.o"
+  "CMakeFiles/sim.dir/Simulation.cpp.o.d"
+  "CMakeFiles/sim.dir/fake/noise.cpp.o"
+  "CMakeFiles/sim.dir/fake/noise.cpp.o.d"
+  "CMakeFiles/sim.dir/fake/plant.cpp.o"
+  "CMakeFiles/sim.dir/fake/plant.cpp.o.d"
+  "CMakeFiles/sim.dir/sim.cpp.o"
+  "CMakeFiles/sim.dir/sim.cpp.o.d"
+  "sim"
+  "sim.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/sim.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/tune.dir/Tuner.cpp.o"
+  "CMakeFiles/tune.dir/Tuner.cpp.o.d"
+  "CMakeFiles/tune.dir/fake/noise.cpp.o"
+  "CMakeFiles/tune.dir/fake/noise.cpp.o.d"
+  "CMakeFiles/tune.dir/fake/plant.cpp.o"
+  "CMakeFiles/tune.dir/fake/plant.cpp.o.d"
+  "CMakeFiles/tune.dir/tune.cpp.o"
+  "CMakeFiles/tune.dir/tune.cpp.o.d"
+  "tune"
+  "tune.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/tune.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
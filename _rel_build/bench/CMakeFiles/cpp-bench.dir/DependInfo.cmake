@@ -0,0 +1,25 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/bench/Angle.cpp" "bench/CMakeFiles/cpp-bench.dir/Angle.cpp.o" "gcc" "bench/CMakeFiles/cpp-bench.dir/Angle.cpp.o.d"
+  "/root/repo/bench/Controller.cpp" "bench/CMakeFiles/cpp-bench.dir/Controller.cpp.o" "gcc" "bench/CMakeFiles/cpp-bench.dir/Controller.cpp.o.d"
+  "/root/repo/bench/FleetController.cpp" "bench/CMakeFiles/cpp-bench.dir/FleetController.cpp.o" "gcc" "bench/CMakeFiles/cpp-bench.dir/FleetController.cpp.o.d"
+  "/root/repo/bench/Limits.cpp" "bench/CMakeFiles/cpp-bench.dir/Limits.cpp.o" "gcc" "bench/CMakeFiles/cpp-bench.dir/Limits.cpp.o.d"
+  "/root/repo/bench/Model.cpp" "bench/CMakeFiles/cpp-bench.dir/Model.cpp.o" "gcc" "bench/CMakeFiles/cpp-bench.dir/Model.cpp.o.d"
+  "/root/repo/bench/PID.cpp" "bench/CMakeFiles/cpp-bench.dir/PID.cpp.o" "gcc" "bench/CMakeFiles/cpp-bench.dir/PID.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel_build/app/CMakeFiles/ackermann_core.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,21 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cpp-bench.dir/Angle.cpp.o"
+  "CMakeFiles/cpp-bench.dir/Angle.cpp.o.d"
+  "CMakeFiles/cpp-bench.dir/Controller.cpp.o"
+  "CMakeFiles/cpp-bench.dir/Controller.cpp.o.d"
+  "CMakeFiles/cpp-bench.dir/FleetController.cpp.o"
+  "CMakeFiles/cpp-bench.dir/FleetController.cpp.o.d"
+  "CMakeFiles/cpp-bench.dir/Limits.cpp.o"
+  "CMakeFiles/cpp-bench.dir/Limits.cpp.o.d"
+  "CMakeFiles/cpp-bench.dir/Model.cpp.o"
+  "CMakeFiles/cpp-bench.dir/Model.cpp.o.d"
+  "CMakeFiles/cpp-bench.dir/PID.cpp.o"
+  "CMakeFiles/cpp-bench.dir/PID.cpp.o.d"
+  "cpp-bench"
+  "cpp-bench.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cpp-bench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
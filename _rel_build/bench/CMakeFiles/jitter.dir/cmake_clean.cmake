@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/jitter.dir/jitter.cpp.o"
+  "CMakeFiles/jitter.dir/jitter.cpp.o.d"
+  "jitter"
+  "jitter.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/jitter.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
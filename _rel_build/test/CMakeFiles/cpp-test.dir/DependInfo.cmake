@@ -0,0 +1,49 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/app/PlotBuffer.cpp" "test/CMakeFiles/cpp-test.dir/__/app/PlotBuffer.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/__/app/PlotBuffer.cpp.o.d"
+  "/root/repo/app/Simulation.cpp" "test/CMakeFiles/cpp-test.dir/__/app/Simulation.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/__/app/Simulation.cpp.o.d"
+  "/root/repo/app/Tuner.cpp" "test/CMakeFiles/cpp-test.dir/__/app/Tuner.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/__/app/Tuner.cpp.o.d"
+  "/root/repo/app/fake/noise.cpp" "test/CMakeFiles/cpp-test.dir/__/app/fake/noise.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/__/app/fake/noise.cpp.o.d"
+  "/root/repo/app/fake/plant.cpp" "test/CMakeFiles/cpp-test.dir/__/app/fake/plant.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/__/app/fake/plant.cpp.o.d"
+  "/root/repo/test/main.cpp" "test/CMakeFiles/cpp-test.dir/main.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/main.cpp.o.d"
+  "/root/repo/test/system.cpp" "test/CMakeFiles/cpp-test.dir/system.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/system.cpp.o.d"
+  "/root/repo/test/unit/Angle.cpp" "test/CMakeFiles/cpp-test.dir/unit/Angle.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Angle.cpp.o.d"
+  "/root/repo/test/unit/CommandHistory.cpp" "test/CMakeFiles/cpp-test.dir/unit/CommandHistory.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/CommandHistory.cpp.o.d"
+  "/root/repo/test/unit/Controller.cpp" "test/CMakeFiles/cpp-test.dir/unit/Controller.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Controller.cpp.o.d"
+  "/root/repo/test/unit/Executor.cpp" "test/CMakeFiles/cpp-test.dir/unit/Executor.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Executor.cpp.o.d"
+  "/root/repo/test/unit/FleetController.cpp" "test/CMakeFiles/cpp-test.dir/unit/FleetController.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/FleetController.cpp.o.d"
+  "/root/repo/test/unit/FlightRecorder.cpp" "test/CMakeFiles/cpp-test.dir/unit/FlightRecorder.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/FlightRecorder.cpp.o.d"
+  "/root/repo/test/unit/Limits.cpp" "test/CMakeFiles/cpp-test.dir/unit/Limits.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Limits.cpp.o.d"
+  "/root/repo/test/unit/Model.cpp" "test/CMakeFiles/cpp-test.dir/unit/Model.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Model.cpp.o.d"
+  "/root/repo/test/unit/Noise.cpp" "test/CMakeFiles/cpp-test.dir/unit/Noise.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Noise.cpp.o.d"
+  "/root/repo/test/unit/Notifier.cpp" "test/CMakeFiles/cpp-test.dir/unit/Notifier.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Notifier.cpp.o.d"
+  "/root/repo/test/unit/PID.cpp" "test/CMakeFiles/cpp-test.dir/unit/PID.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/PID.cpp.o.d"
+  "/root/repo/test/unit/Params.cpp" "test/CMakeFiles/cpp-test.dir/unit/Params.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Params.cpp.o.d"
+  "/root/repo/test/unit/PlotBuffer.cpp" "test/CMakeFiles/cpp-test.dir/unit/PlotBuffer.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/PlotBuffer.cpp.o.d"
+  "/root/repo/test/unit/Realtime.cpp" "test/CMakeFiles/cpp-test.dir/unit/Realtime.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Realtime.cpp.o.d"
+  "/root/repo/test/unit/SeqLock.cpp" "test/CMakeFiles/cpp-test.dir/unit/SeqLock.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/SeqLock.cpp.o.d"
+  "/root/repo/test/unit/SharedMemory.cpp" "test/CMakeFiles/cpp-test.dir/unit/SharedMemory.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/SharedMemory.cpp.o.d"
+  "/root/repo/test/unit/Simulation.cpp" "test/CMakeFiles/cpp-test.dir/unit/Simulation.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Simulation.cpp.o.d"
+  "/root/repo/test/unit/SpscRing.cpp" "test/CMakeFiles/cpp-test.dir/unit/SpscRing.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/SpscRing.cpp.o.d"
+  "/root/repo/test/unit/StageProfiler.cpp" "test/CMakeFiles/cpp-test.dir/unit/StageProfiler.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/StageProfiler.cpp.o.d"
+  "/root/repo/test/unit/TimingStats.cpp" "test/CMakeFiles/cpp-test.dir/unit/TimingStats.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/TimingStats.cpp.o.d"
+  "/root/repo/test/unit/Trajectory.cpp" "test/CMakeFiles/cpp-test.dir/unit/Trajectory.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Trajectory.cpp.o.d"
+  "/root/repo/test/unit/Tuner.cpp" "test/CMakeFiles/cpp-test.dir/unit/Tuner.cpp.o" "gcc" "test/CMakeFiles/cpp-test.dir/unit/Tuner.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_rel_build/app/CMakeFiles/ackermann_core.dir/DependInfo.cmake"
+  "/root/repo/_rel_build/vendor/googletest/googletest/CMakeFiles/gtest.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,67 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/cpp-test.dir/__/app/PlotBuffer.cpp.o"
+  "CMakeFiles/cpp-test.dir/__/app/PlotBuffer.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/__/app/Simulation.cpp.o"
+  "CMakeFiles/cpp-test.dir/__/app/Simulation.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/__/app/Tuner.cpp.o"
+  "CMakeFiles/cpp-test.dir/__/app/Tuner.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/__/app/fake/noise.cpp.o"
+  "CMakeFiles/cpp-test.dir/__/app/fake/noise.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/__/app/fake/plant.cpp.o"
+  "CMakeFiles/cpp-test.dir/__/app/fake/plant.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/main.cpp.o"
+  "CMakeFiles/cpp-test.dir/main.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/system.cpp.o"
+  "CMakeFiles/cpp-test.dir/system.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Angle.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Angle.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/CommandHistory.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/CommandHistory.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Controller.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Controller.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Executor.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Executor.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/FleetController.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/FleetController.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/FlightRecorder.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/FlightRecorder.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Limits.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Limits.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Model.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Model.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Noise.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Noise.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Notifier.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Notifier.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/PID.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/PID.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Params.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Params.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/PlotBuffer.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/PlotBuffer.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Realtime.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Realtime.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/SeqLock.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/SeqLock.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/SharedMemory.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/SharedMemory.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Simulation.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Simulation.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/SpscRing.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/SpscRing.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/StageProfiler.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/StageProfiler.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/TimingStats.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/TimingStats.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Trajectory.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Trajectory.cpp.o.d"
+  "CMakeFiles/cpp-test.dir/unit/Tuner.cpp.o"
+  "CMakeFiles/cpp-test.dir/unit/Tuner.cpp.o.d"
+  "cpp-test"
+  "cpp-test.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/cpp-test.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
@@ -0,0 +1,20 @@
+/* @file Angle.cpp
+ * @brief Constant time angle wrapping.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <Angle.hpp>
+
+namespace ackermann {
+
+void wrapAngles(const double* angles, double* wrapped, const std::size_t n) {
+  for (std::size_t i = 0; i < n; ++i)
+    wrapped[i] = wrapAngle(angles[i]);
+}
+
+}  // namespace ackermann
@@ -0,0 +1,79 @@
+/* @file CommandHistory.cpp
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <CommandHistory.hpp>
+
+#include <algorithm>
+#include <chrono>
+
+#include <Angle.hpp>
+
+namespace ackermann {
+
+constexpr std::size_t CommandHistory::kCapacity;
+
+void CommandHistory::push(const Clock::time_point stamp,
+                          const double dt,
+                          const double speed,
+                          const double heading_rate) {
+  entries_[next_] = {
+    stamp,
+    std::chrono::duration_cast<Clock::duration>(
+      std::chrono::duration<double>(dt)),
+    speed,
+    heading_rate};
+  next_ = (next_ + 1) % kCapacity;
+  size_ = std::min(size_ + 1, kCapacity);
+}
+
+void CommandHistory::clear() {
+  size_ = 0;
+  next_ = 0;
+}
+
+std::size_t CommandHistory::size() const {
+  return size_;
+}
+
+StateSample CommandHistory::predict(const StateSample& measured,
+                                    const Clock::time_point now) const {
+  StateSample predicted = measured;
+  if (!size_ || measured.stamp >= now)
+    return predicted;
+
+  // walk from the oldest command to the newest, integrating the turn made
+  // between the measurement and now, and noting the speed commanded at the
+  // time of the measurement
+  bool known = false;
+  double measured_speed = 0.0;
+  double latest_speed = 0.0;
+  double turn = 0.0;
+  const std::size_t oldest = (next_ + kCapacity - size_) % kCapacity;
+  for (std::size_t i = 0; i != size_; ++i) {
+    const Entry& entry = entries_[(oldest + i) % kCapacity];
+    const Clock::time_point start = std::max(entry.stamp, measured.stamp);
+    const Clock::time_point end = std::min(entry.stamp + entry.dt, now);
+    if (end > start)
+      turn += entry.heading_rate
+        * std::chrono::duration<double>(end - start).count();
+    if (entry.stamp < measured.stamp) {
+      measured_speed = entry.speed;
+      known = true;
+    }
+    if (entry.stamp < now)
+      latest_speed = entry.speed;
+  }
+
+  if (known)
+    predicted.speed += latest_speed - measured_speed;
+  predicted.heading = wrapAngle(predicted.heading + turn);
+  return predicted;
+}
+
+}  // namespace ackermann
@@ -8,159 +8,534 @@
  */
 
 // @TODO Currently STUB implementation; needs to be filled
-#include <iostream>
 #include <Controller.hpp>
 
+#include <cmath>
+#include <cstring>
+#include <utility>
+
 namespace ackermann {
 
 using std::chrono::steady_clock;
 using std::chrono::duration;
 
-Controller::Controller(const std::shared_ptr<const Params>& params)
-  : params_(params),
-    limits_(std::make_unique<Limits>(params)),
-    model_(std::make_unique<Model>(params)) {
-    this->pid_throttle_ = std::make_unique<PID>(
-      params_->pid_speed,
-      (params_->throttle_min - params_->throttle_max),
-      (params_->throttle_max - params_->throttle_min));
-    this->pid_heading_ = std::make_unique<PID>(
-      params_->pid_heading,
-      -2*params_->max_steering_angle,
-      2*params_->max_steering_angle);
+namespace {
+
+// speed below which the turn rate can't be steered (m/s)
+constexpr double kMinFeedForwardSpeed = 1e-3;
+
+// reads of inputs published by other threads, before giving up on a tick
+constexpr unsigned kReadAttempts = 16;
+
+// per-stage instrumentation of update(), compiled in on request
+#ifdef ACKERMANN_PROFILE_STAGES
+#define PROFILE_BEGIN(tick) this->profiler_.begin(tick)
+#define PROFILE_MARK(stage) this->profiler_.mark(Stage::stage)
+#define PROFILE_END() this->profiler_.end()
+#else
+#define PROFILE_BEGIN(tick) ((void)0)
+#define PROFILE_MARK(stage) ((void)0)
+#define PROFILE_END() ((void)0)
+#endif
+
+uint64_t nanoseconds(const steady_clock::duration d) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+}  // namespace
+
+Controller::Controller(const std::shared_ptr<const Params>& params,
+                       const std::size_t telemetry_capacity)
+  : params_owner_(params),
+    params_(*params),
+    limits_(params),
+    model_(params),
+    pid_throttle_(params->pid_speed,
+                  (params->throttle_min - params->throttle_max),
+                  (params->throttle_max - params->throttle_min)),
+    pid_heading_(params->pid_heading,
+                 -2*params->max_steering_angle,
+                 2*params->max_steering_angle),
+    telemetry_(telemetry_capacity) {
 }
 
 Controller::~Controller() {
   stop(true);
+  // the loop has stopped, so no subscriber list remains in use
+  delete subscribers_.load();
+  for (const auto& retired : retired_)
+    delete retired.second;
 }
 
 void Controller::start() {
   // rejoin any existing thread
   stop(true);
 
-  // spin off a thread processing our control loop
+  // spin off a thread processing our control loop; wait for it to apply
+  // our realtime options so that their outcome can be reported
   cancel_ = false;
-  control_loop_handle_ = std::thread([this](){this->controlLoop();});
+  timing_.reset();
+#ifdef ACKERMANN_PROFILE_STAGES
+  profiler_.reset();
+#endif
+
+  // when given an executor, schedule our first tick on its workers instead
+  if (executor_) {
+    active_executor_ = executor_;
+    realtime_status_ = RealtimeStatus();
+    beginLoop();
+    active_executor_->add(this, next_loop_time_);
+    return;
+  }
+
+  // (the thread owns the promise, which may still be in use once we wake)
+  std::promise<RealtimeStatus> status;
+  std::future<RealtimeStatus> applied = status.get_future();
+  control_loop_handle_ = std::thread([this, status = std::move(status)]()
+                                     mutable {
+    status.set_value(applyRealtimeOptions(realtime_options_));
+    this->controlLoop();
+  });
+  realtime_status_ = applied.get();
+}
+
+void Controller::setRealtimeOptions(const RealtimeOptions& options) {
+  realtime_options_ = options;
+}
+
+void Controller::setExecutor(const std::shared_ptr<Executor>& executor) {
+  executor_ = executor;
+}
+
+RealtimeStatus Controller::getRealtimeStatus() const {
+  return realtime_status_;
+}
+
+TimingStats Controller::getTimingStats() const {
+  return timing_.stats();
 }
 
 void Controller::stop(bool block) {
   // set cancel; optionally wait for the thread to return
   cancel_ = true;
+  if (active_executor_) {
+    active_executor_->remove(this, block);
+    if (block)
+      active_executor_.reset();
+  }
   if (block && control_loop_handle_.joinable())
     control_loop_handle_.join();
 }
 
 void Controller::reset() {
-  pid_throttle_->reset_PID();
-  pid_heading_->reset_PID();
-  model_->reset();
+  pid_throttle_.reset_PID();
+  pid_heading_.reset_PID();
+  model_.reset();
+  measurement_.store(StateSample());
+  history_.clear();
+  if (recorder_)
+    recorder_->recordReset();
+}
+
+void Controller::step(const double dt) {
+  // lockstep execution is mutually exclusive with the asynchronous loop
+  assert(!isRunning());
+  this->update(params_.snapshot(), dt, Clock::now());
+}
+
+void Controller::step(const double dt, const Clock::time_point now) {
+  assert(!isRunning());
+  this->update(params_.snapshot(), dt, now);
+}
+
+void Controller::step(const double dt,
+                      const Clock::time_point now,
+                      const double throttle_feed_forward,
+                      const double steering_feed_forward) {
+  assert(!isRunning());
+  const FeedForward feed_forward {throttle_feed_forward,
+                                  steering_feed_forward};
+  this->update(params_.snapshot(), dt, now, &feed_forward);
 }
 
 bool Controller::isRunning() const {
-  return control_loop_handle_.joinable();
+  return control_loop_handle_.joinable() || active_executor_;
 }
 
-void Controller::setState(const double speed, const double heading) {
-  this->model_->setState(speed, heading);
+bool Controller::setState(const double speed, const double heading) {
+  return this->setState({speed, heading, Clock::now()});
+}
+
+bool Controller::setState(const StateSample& state) {
+  if (recorder_)
+    recorder_->recordState(state);
+  if (!latency_compensation_.load(std::memory_order_relaxed))
+    return this->model_.setState(state);
+  // (rejecting the same measurements as Model::setState)
+  if (!std::isfinite(state.speed) || std::isnan(wrapAngle(state.heading)))
+    return false;
+  this->measurement_.store(state);
+  return true;
+}
+
+void Controller::setLatencyCompensation(const bool enable) {
+  latency_compensation_ = enable;
 }
 
 void Controller::getState(double& speed, double& heading) const {
-  this->model_->getState(speed, heading);
+  this->model_.getState(speed, heading);
 }
 
-void Controller::setGoal(const double speed, const double heading) {
-  this->model_->setGoal(speed, heading);
+void Controller::getState(StateSample& state) const {
+  this->model_.getState(state);
+}
+
+bool Controller::setGoal(const double speed, const double heading) {
+  return this->setGoal({speed, heading, Clock::now()});
+}
+
+bool Controller::setGoal(const GoalSample& goal) {
+  if (recorder_)
+    recorder_->recordGoal(goal);
+  return this->model_.setGoal(goal);
+}
+
+bool Controller::appendTrajectory(const GoalSample& knot) {
+  return this->trajectory_.append(knot);
+}
+
+std::size_t Controller::appendTrajectory(const GoalSample* knots,
+                                         const std::size_t count) {
+  return this->trajectory_.append(knots, count);
+}
+
+void Controller::clearTrajectory() {
+  this->trajectory_.clear();
+}
+
+void Controller::setFeedForward(const bool enable) {
+  feed_forward_ = enable;
 }
 
 void Controller::getGoal(double& speed, double& heading) const {
-  this->model_->getGoal(speed, heading);
+  this->model_.getGoal(speed, heading);
+}
+
+void Controller::getGoal(GoalSample& goal) const {
+  this->model_.getGoal(goal);
 }
 
 void Controller::getCommand(double& throttle, double& steering) const {
-  this->model_->getCommand(throttle, steering);
+  this->model_.getCommand(throttle, steering);
+}
+
+void Controller::getCommand(CommandSample& command) const {
+  command = this->command_.load();
+}
+
+bool Controller::waitForCommand(const uint64_t after,
+                                CommandSample& command,
+                                const Clock::duration timeout) const {
+  const Clock::time_point deadline = timeout == Clock::duration::max()
+    ? Clock::time_point::max() : Clock::now() + timeout;
+  while (true) {
+    // read the event count before the command, so that a command published
+    // in between wakes us up
+    const uint32_t event = command_event_.value();
+    command = command_.load();
+    if (command.sequence > after)
+      return true;
+    if (!command_event_.wait(event, deadline)) {
+      command = command_.load();
+      return command.sequence > after;
+    }
+  }
+}
+
+std::size_t Controller::subscribe(CommandCallback callback) {
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
+  auto subscribers = std::make_unique<Subscribers>();
+  if (const Subscribers* current = subscribers_.load())
+    *subscribers = *current;
+  const std::size_t id = next_subscriber_++;
+  subscribers->emplace_back(id, std::move(callback));
+  publishSubscribers(std::move(subscribers));
+  return id;
+}
+
+void Controller::unsubscribe(const std::size_t id) {
+  std::lock_guard<std::mutex> lock(subscribers_mutex_);
+  auto subscribers = std::make_unique<Subscribers>();
+  if (const Subscribers* current = subscribers_.load())
+    for (const auto& subscriber : *current)
+      if (subscriber.first != id)
+        subscribers->push_back(subscriber);
+  publishSubscribers(std::move(subscribers));
+}
+
+void Controller::publishSubscribers(std::unique_ptr<Subscribers> subscribers) {
+  // swap in the new list; the control thread may still be using the old one
+  // until its current dispatch (if any) completes
+  const Subscribers* old = subscribers_.exchange(subscribers.release());
+  const uint64_t dispatches = dispatches_.load();
+  if (old)
+    retired_.emplace_back((dispatches + 1) & ~uint64_t(1), old);
+
+  // free every retired list which is no longer in use
+  const uint64_t completed = dispatches_.load();
+  auto in_use = retired_.begin();
+  for (auto it = retired_.begin(); it != retired_.end(); ++it) {
+    if (completed >= it->first)
+      delete it->second;
+    else
+      *in_use++ = *it;
+  }
+  retired_.erase(in_use, retired_.end());
 }
 
 void Controller::getWheelLinVel(double& left_front,
                                 double& right_front,
                                 double& left_rear,
                                 double& right_rear) const {
-  this->model_->getWheelLinVel(left_front, right_front, left_rear, right_rear);
+  this->model_.getWheelLinVel(left_front, right_front, left_rear, right_rear);
+}
+
+std::size_t Controller::drainTelemetry(TelemetryRecord* records,
+                                       const std::size_t max) {
+  return this->telemetry_.drain(records, max);
+}
+
+uint64_t Controller::getTelemetryDropped() const {
+  return this->telemetry_.dropped();
+}
+
+std::size_t Controller::getTelemetryCapacity() const {
+  return this->telemetry_.capacity();
+}
+
+#ifdef ACKERMANN_PROFILE_STAGES
+StageProfiler& Controller::getStageProfiler() {
+  return this->profiler_;
+}
+#endif
+
+void Controller::setRecorder(
+    const std::shared_ptr<FlightRecorder>& recorder) {
+  recorder_owner_ = recorder;
+  recorder_ = recorder.get();
+  params_recorded_ = false;
 }
 
 void Controller::controlLoop() {
-  // loop monitoring variables
-  unsigned int timing_violations = 0;
-  const double timing_threshold = 0.1;
+  // execute loop at the desired frequency
+  beginLoop();
+  while (!cancel_)
+    std::this_thread::sleep_until(tick());
+}
 
+void Controller::beginLoop() {
   // initialize timing variables
-  std::chrono::microseconds duration(
-    static_cast<int>(1000000 / params_->control_frequency));
-  auto next_loop_time = steady_clock::now();
+  loop_period_ = std::chrono::duration_cast<steady_clock::duration>(
+    duration<double>(1 / params_.control_frequency));
+  next_loop_time_ = steady_clock::now();
+  last_loop_start_ = next_loop_time_;
+  first_loop_ = true;
+}
 
-  // execute loop at the desired frequency
-  while (!cancel_) {
-    // update next target time
-    double dT = 1/params_->control_frequency;
-
-    // get goal values
-    double desired_speed, desired_heading;
-    this->model_->getGoal(desired_speed, desired_heading);
-
-    // get model current state
-    double current_speed, current_heading;
-    this->model_->getState(current_speed, current_heading);
-
-    // get current throttle, current steering, current steering velocity
-    double current_throttle, current_steering, current_steering_vel;
-    this->model_->getCommand(current_throttle,
-                             current_steering,
-                             current_steering_vel);
-
-    // convert speed error to throttle error
-    double throttle_error = limits_->speedToThrottle(desired_speed)
-         - limits_->speedToThrottle(current_speed);
-
-    // get speed error and heading error
-    double speed_error, heading_error;
-    this->model_->getError(speed_error, heading_error);
-
-    // PID controller
-    double command_throttle =
-      current_throttle + this->pid_throttle_->getCommand(throttle_error, dT);
-    double command_steering =
-      this->pid_heading_->getCommand(heading_error, dT);
-    double command_steering_vel;
-
-    // apply limits and generate commands
-    this->limits_->limit(current_speed,
-                         current_steering,
-                         current_steering_vel,
-                         command_throttle,
-                         command_steering,
-                         command_steering_vel,
-                         dT);
-
-    // apply commands
-    this->model_->command(command_throttle, command_steering, dT);
-
-    // sleep until next loop
-    std::this_thread::sleep_until(next_loop_time + duration);
-
-    // check and warn if this loop time is longer or shorter than expected
-    auto actual_duration =
-      std::chrono::duration_cast<std::chrono::microseconds>(
-        steady_clock::now() - next_loop_time);
-    double timing_ratio = static_cast<double>(
-      actual_duration.count() - duration.count())/duration.count();
-    if (std::abs(timing_ratio) > timing_threshold)
-      // increment problem count
-      std::cerr << "Loop frequency violation #" << ++timing_violations
-                << ": off by " << static_cast<int>(timing_ratio * 100)
-                << "%" << std::endl;
-
-    // update next loop time
-    next_loop_time += duration;
+steady_clock::time_point Controller::tick() {
+  const auto start = steady_clock::now();
+
+  // take a consistent copy of our parameters for this iteration, and
+  // execute a single iteration at our nominal time step (and at its
+  // scheduled time, regardless of any jitter in waking up)
+  const ParamsSnapshot params = params_.snapshot();
+  this->update(params, 1/params.control_frequency, next_loop_time_);
+
+  // record how long this took, and how it lined up with our schedule
+  const auto end = steady_clock::now();
+  const auto deadline = next_loop_time_ + loop_period_;
+  const uint64_t lateness = start > next_loop_time_
+    ? nanoseconds(start - next_loop_time_) : 0;
+  uint64_t missed = 0;
+  if (end > deadline) {
+    // skip (rather than burst through) any ticks we've fallen behind on
+    missed = (end - deadline) / loop_period_;
+    next_loop_time_ += missed * loop_period_;
+  }
+  timing_.record(first_loop_ ? 0 : nanoseconds(start - last_loop_start_),
+                 nanoseconds(end - start),
+                 lateness,
+                 end > deadline,
+                 missed);
+  first_loop_ = false;
+  last_loop_start_ = start;
+
+  // schedule the next loop
+  next_loop_time_ += loop_period_;
+  return next_loop_time_;
+}
+
+void Controller::update(const ParamsSnapshot& params,
+                        const double dt,
+                        const Clock::time_point now,
+                        const FeedForward* feed_forward) {
+  PROFILE_BEGIN(tick_);
+
+  // consume any new state and setpoint (should a writer stall mid-update,
+  // its input waits for a later iteration)
+  this->model_.sync();
+
+  // follow our trajectory (if any), publishing its setpoint as the goal
+  TrajectorySetpoint setpoint;
+  const bool following = this->trajectory_.sample(now, setpoint)
+    && this->model_.adoptGoal(setpoint.goal);
+
+  // roll our latest measurement (if any) forward to the present
+  StateSample measured;
+  if (latency_compensation_.load(std::memory_order_relaxed)
+      && this->measurement_.tryLoad(measured, kReadAttempts)) {
+    if (measured.stamp != Clock::time_point())
+      this->model_.adoptState(this->history_.predict(measured, now));
+  }
+
+  // get goal values and model current state (owned by this thread)
+  GoalSample goal;
+  StateSample state;
+  this->model_.getInputs(state, goal);
+  const double current_speed = state.speed;
+
+  // get current throttle, current steering, current steering velocity
+  double current_throttle, current_steering, current_steering_vel;
+  this->model_.getCommand(current_throttle,
+                           current_steering,
+                           current_steering_vel);
+
+  // convert speed error to throttle error
+  double throttle_error = limits_.speedToThrottle(params, goal.speed)
+    - limits_.speedToThrottle(params, current_speed);
+
+  // get heading error (from the same snapshots, minimizing the turn)
+  double heading_error = limits_.shortestArcToTurn(state.heading,
+                                                    goal.heading);
+
+  PROFILE_MARK(Inputs);
+
+  // begin this iteration's telemetry
+  TelemetryRecord record;
+  record.tick = tick_++;
+  record.stamp = now;
+  record.state = state;
+  record.goal = goal;
+  record.speed_error = goal.speed - state.speed;
+  record.heading_error = heading_error;
+  record.throttle_error = throttle_error;
+
+  // PID controller
+  double command_throttle = current_throttle
+    + this->pid_throttle_.getCommand(throttle_error, dt, params.pid_speed);
+  double command_steering =
+    this->pid_heading_.getCommand(heading_error, dt, params.pid_heading);
+  double command_steering_vel;
+
+  // feed forward the trajectory's rates: the throttle change which produces
+  // its acceleration, and the steering angle which produces its turn rate
+  // (or, when replaying, the recorded feed-forward)
+  if (feed_forward) {
+    record.throttle_feed_forward = feed_forward->throttle;
+    record.steering_feed_forward = feed_forward->steering;
+    command_throttle += record.throttle_feed_forward;
+    command_steering += record.steering_feed_forward;
+  } else if (following && feed_forward_.load(std::memory_order_relaxed)) {
+    record.throttle_feed_forward = setpoint.speed_rate * dt
+      / params.velocity_max;
+    if (std::abs(current_speed) > kMinFeedForwardSpeed)
+      record.steering_feed_forward = std::atan(
+        params.wheel_base * setpoint.heading_rate / current_speed);
+    command_throttle += record.throttle_feed_forward;
+    command_steering += record.steering_feed_forward;
   }
+
+  PROFILE_MARK(PID);
+
+  // apply limits and generate commands
+  this->limits_.limit(params,
+                       current_speed,
+                       current_steering,
+                       current_steering_vel,
+                       command_throttle,
+                       command_steering,
+                       command_steering_vel,
+                       dt);
+
+  PROFILE_MARK(Limits);
+
+  // apply commands
+  this->model_.command(params, command_throttle, command_steering, dt);
+  const double command_speed =
+    this->limits_.throttleToSpeed(params, command_throttle);
+  this->history_.push(now, dt, command_speed,
+                      command_speed / params.wheel_base
+                        * std::tan(command_steering));
+
+  PROFILE_MARK(Model);
+
+  // publish the command: wake any waiting clients, then notify subscribers
+  const CommandSample command {record.tick + 1, command_throttle,
+                               command_steering, record.stamp};
+  this->command_.store(command);
+  this->command_event_.notify();
+  const uint64_t dispatches = dispatches_.load(std::memory_order_relaxed);
+  dispatches_.store(dispatches + 1);
+  if (const Subscribers* subscribers = subscribers_.load())
+    for (const auto& subscriber : *subscribers)
+      subscriber.second(command);
+  dispatches_.store(dispatches + 2, std::memory_order_release);
+
+  PROFILE_MARK(Publish);
+
+  // publish this iteration's telemetry, and record any parameter changes
+  // followed by this iteration (unless neither is consumed)
+  const bool telemetry = this->telemetry_.capacity() != 0;
+  if (telemetry || recorder_) {
+    record.throttle_terms = this->pid_throttle_.getTerms();
+    record.heading_terms = this->pid_heading_.getTerms();
+    record.throttle = command_throttle;
+    record.steering = command_steering;
+    record.steering_vel = command_steering_vel;
+    this->model_.getWheelLinVel(record.wheel_left_front,
+                                 record.wheel_right_front,
+                                 record.wheel_left_rear,
+                                 record.wheel_right_rear);
+    if (telemetry)
+      this->telemetry_.push(record);
+    if (recorder_) {
+      if (!params_recorded_
+          || std::memcmp(&params, &recorded_params_, sizeof(params))) {
+        recorder_->recordParams(params);
+        recorded_params_ = params;
+        params_recorded_ = true;
+      }
+      recorder_->recordTick(record, dt);
+    }
+  }
+
+  PROFILE_MARK(Telemetry);
+  PROFILE_END();
+}
+
+ControllerBlock::ControllerBlock(const double wheel_base,
+                                 const double track_width,
+                                 const double max_steering_angle,
+                                 const double kp_speed,
+                                 const double kp_heading)
+  : pid_speed(kp_speed),
+    pid_heading(kp_heading),
+    // (non owning pointers, aliasing an empty shared_ptr)
+    params(wheel_base, track_width, max_steering_angle,
+           std::shared_ptr<PIDParams>(std::shared_ptr<void>(), &pid_speed),
+           std::shared_ptr<PIDParams>(std::shared_ptr<void>(), &pid_heading)),
+    controller(std::shared_ptr<const Params>(std::shared_ptr<void>(),
+                                             &params)) {
 }
 
 }  // namespace ackermann
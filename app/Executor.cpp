@@ -0,0 +1,163 @@
+/* @file Executor.cpp
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <Executor.hpp>
+
+#include <assert.h>
+#include <algorithm>
+
+#include <Controller.hpp>
+
+namespace ackermann {
+
+Executor::Executor(const std::size_t workers, const RealtimeOptions& options)
+  : realtime_status_(std::max<std::size_t>(workers, 1)) {
+  // start every worker, waiting for each to apply our realtime options
+  std::size_t started = 0;
+  for (std::size_t i = 0; i != realtime_status_.size(); ++i) {
+    workers_.emplace_back([this, i, &options, &started](){
+      const RealtimeStatus status = applyRealtimeOptions(options);
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        realtime_status_[i] = status;
+        ++started;
+      }
+      done_.notify_all();
+      this->work();
+    });
+  }
+  std::unique_lock<std::mutex> lock(mutex_);
+  done_.wait(lock, [&](){ return started == workers_.size(); });
+}
+
+Executor::~Executor() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancel_ = true;
+  }
+  timer_.notify_all();
+  idle_.notify_all();
+  for (auto& worker : workers_)
+    worker.join();
+}
+
+std::size_t Executor::workers() const {
+  return workers_.size();
+}
+
+std::size_t Executor::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::size_t scheduled = 0;
+  for (const auto& slot : slots_)
+    if (slot.second.scheduled)
+      ++scheduled;
+  return scheduled;
+}
+
+std::vector<RealtimeStatus> Executor::getRealtimeStatus() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return realtime_status_;
+}
+
+void Executor::add(Controller* controller, const TimePoint first) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  // wait for any tick of a previous (removed) schedule to complete
+  assert(!slots_.count(controller) || !slots_[controller].scheduled);
+  done_.wait(lock, [&](){ return !slots_.count(controller); });
+  slots_[controller] = {true, false};
+  // (there is at most one entry per slot, so rescheduling never allocates)
+  deadlines_.reserve(slots_.size());
+  if (schedule({first, controller}))
+    wakeTimer();
+}
+
+void Executor::remove(Controller* controller, const bool block) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto slot = slots_.find(controller);
+  if (slot == slots_.end())
+    return;
+
+  // an idle controller's entry is removed from the heap right away
+  if (!slot->second.busy) {
+    slots_.erase(slot);
+    const auto entry = std::find_if(deadlines_.begin(), deadlines_.end(),
+      [controller](const Entry& e){ return e.controller == controller; });
+    if (entry != deadlines_.end()) {
+      deadlines_.erase(entry);
+      std::make_heap(deadlines_.begin(), deadlines_.end());
+    }
+    return;
+  }
+
+  // a busy controller isn't in the heap; its slot is erased (rather than
+  // rescheduled) once its tick completes
+  slot->second.scheduled = false;
+  if (block)
+    done_.wait(lock, [&](){ return !slots_.count(controller); });
+}
+
+bool Executor::schedule(const Entry& entry) {
+  deadlines_.push_back(entry);
+  std::push_heap(deadlines_.begin(), deadlines_.end());
+  return deadlines_.front().controller == entry.controller;
+}
+
+void Executor::wakeTimer() {
+  // the timer must now wait for an earlier deadline; without one, any
+  // idle worker takes its place
+  if (timing_)
+    timer_.notify_one();
+  else
+    idle_.notify_one();
+}
+
+void Executor::work() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!cancel_) {
+    // only one worker (the timer) sleeps until the earliest deadline; the
+    // others sleep until they're needed, so they never all wake together
+    if (deadlines_.empty() || timing_) {
+      idle_.wait(lock);
+      continue;
+    }
+    const Entry next = deadlines_.front();
+    if (std::chrono::steady_clock::now() < next.deadline) {
+      timing_ = true;
+      timer_.wait_until(lock, next.deadline);
+      timing_ = false;
+      continue;
+    }
+
+    // claim this tick, and hand the following deadline to another worker
+    std::pop_heap(deadlines_.begin(), deadlines_.end());
+    deadlines_.pop_back();
+    auto slot = slots_.find(next.controller);
+    slot->second.busy = true;
+    if (!deadlines_.empty())
+      idle_.notify_one();
+
+    lock.unlock();
+    const TimePoint following = next.controller->tick();
+    lock.lock();
+
+    // reschedule, unless the controller was removed in the meantime
+    slot = slots_.find(next.controller);
+    slot->second.busy = false;
+    if (slot->second.scheduled) {
+      // (we're awake, so only a sleeping timer needs waking)
+      if (schedule({following, next.controller}) && timing_)
+        timer_.notify_one();
+    } else {
+      slots_.erase(slot);
+      done_.notify_all();
+    }
+  }
+}
+
+}  // namespace ackermann
@@ -0,0 +1,344 @@
+/* @file FleetController.cpp
+ * @brief Structure-of-arrays implementation of the Ackermann controller.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <FleetController.hpp>
+#include <Angle.hpp>
+#include <Kinematics.hpp>
+
+#include <algorithm>
+#include <cmath>
+
+namespace ackermann {
+
+namespace {
+
+/**
+* @brief Parameter values used by the fleet kernel (taken once per step).
+*/
+struct FleetParams : public ParamsSnapshot {
+  double throttle_out_min, throttle_out_max;
+  double heading_out_min, heading_out_max;
+};
+
+// branch free equivalents of the Limits conversion methods; note that every
+// operation is executed unconditionally and then selected, which allows
+// the compiler to if-convert (and vectorize) these without speculation.
+inline double speedToThrottle(const FleetParams& p, double speed) {
+  speed = speed > p.velocity_max ? p.velocity_max : speed;
+  speed = speed < p.velocity_min ? p.velocity_min : speed;
+  const double throttle = speed / p.velocity_max;
+  return speed <= 0 ? 0.0 : throttle;
+}
+
+inline double throttleToSpeed(const FleetParams& p, double throttle) {
+  throttle = throttle > p.throttle_max ? p.throttle_max : throttle;
+  throttle = throttle < p.throttle_min ? p.throttle_min : throttle;
+  const double speed = throttle * p.velocity_max;
+  return throttle <= 0 ? 0.0 : speed;
+}
+
+// branch free equivalent of PID::getCommand
+inline double pidCommand(const double error,
+                         const double dt,
+                         const PIDGains& gains,
+                         const double out_min,
+                         const double out_max,
+                         double& integral,
+                         double& prev_error) {
+  double integ = integral + error * dt;
+  double derivative = (error - prev_error) / dt;
+  double output = (gains.kp*error) + (gains.ki*integ)
+    + (gains.kd*derivative);
+  // PID windup
+  const bool above = output > out_max;
+  const bool below = output < out_min;
+  const double integ_above = integ - (output - out_max);
+  const double integ_below = integ + (out_min - output);
+  integ = below ? integ_below : integ;
+  integ = above ? integ_above : integ;
+  output = below ? out_min : output;
+  output = above ? out_max : output;
+  integral = integ;
+  prev_error = error;
+  return output;
+}
+
+/**
+* @brief Execute one iteration of the PID, limit and (non transcendental)
+* model update math over n vehicles.
+*
+* The state arrays never alias each other; this is stated both via the
+* restricted parameters and (since GCC drops restrict when inlining) by
+* an explicit ivdep, which lets the compiler vectorize without alias checks.
+*/
+void controlKernel(const FleetParams p,
+                   const std::size_t n,
+                   const double dt,
+                   const double* __restrict goal_speed,
+                   const double* __restrict goal_heading,
+                   const double* __restrict heading,
+                   double* __restrict speed,
+                   double* __restrict throttle,
+                   double* __restrict steering,
+                   double* __restrict steering_vel,
+                   double* __restrict t_integral,
+                   double* __restrict t_prev,
+                   double* __restrict h_integral,
+                   double* __restrict h_prev) {
+  // throttle values corresponding to saturated velocities
+  const double vel_max_throttle = speedToThrottle(p, p.velocity_max);
+  const double vel_min_throttle = speedToThrottle(p, p.velocity_min);
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC ivdep
+#endif
+  for (std::size_t i = 0; i < n; ++i) {
+    const double cur_speed = speed[i];
+    const double cur_steering = steering[i];
+    const double cur_steering_vel = steering_vel[i];
+
+    // convert speed error to throttle error
+    const double throttle_error = speedToThrottle(p, goal_speed[i])
+      - speedToThrottle(p, cur_speed);
+
+    // minimize heading error (Limits::shortestArcToTurn)
+    double heading_error = goal_heading[i] - heading[i];
+    heading_error = heading_error > M_PI ? heading_error - 2*M_PI
+                                         : heading_error;
+    heading_error = heading_error < -M_PI ? heading_error + 2*M_PI
+                                          : heading_error;
+
+    // PID controllers
+    double cmd_throttle = throttle[i]
+      + pidCommand(throttle_error, dt, p.pid_speed,
+                   p.throttle_out_min, p.throttle_out_max,
+                   t_integral[i], t_prev[i]);
+    double cmd_steering =
+      pidCommand(heading_error, dt, p.pid_heading,
+                 p.heading_out_min, p.heading_out_max,
+                 h_integral[i], h_prev[i]);
+
+    // BEGIN THROTTLE LIMITATION SECTION (Limits::limit)
+    // (candidate values are computed unconditionally and then selected)
+    cmd_throttle = cmd_throttle > p.throttle_max ? p.throttle_max
+                                                 : cmd_throttle;
+    cmd_throttle = cmd_throttle < p.throttle_min ? p.throttle_min
+                                                 : cmd_throttle;
+    double new_velocity = throttleToSpeed(p, cmd_throttle);
+    bool clip = new_velocity > p.velocity_max;
+    new_velocity = clip ? p.velocity_max : new_velocity;
+    cmd_throttle = clip ? vel_max_throttle : cmd_throttle;
+    clip = new_velocity < p.velocity_min;
+    new_velocity = clip ? p.velocity_min : new_velocity;
+    cmd_throttle = clip ? vel_min_throttle : cmd_throttle;
+
+    double accel = (new_velocity - cur_speed) / dt;
+    const double accel_max_velocity = cur_speed + p.acceleration_max * dt;
+    const double accel_max_throttle = speedToThrottle(p, accel_max_velocity);
+    clip = accel > p.acceleration_max;
+    accel = clip ? p.acceleration_max : accel;
+    new_velocity = clip ? accel_max_velocity : new_velocity;
+    cmd_throttle = clip ? accel_max_throttle : cmd_throttle;
+    const double accel_min_velocity = cur_speed + p.acceleration_min * dt;
+    const double accel_min_throttle = speedToThrottle(p, accel_min_velocity);
+    clip = accel < p.acceleration_min;
+    new_velocity = clip ? accel_min_velocity : new_velocity;
+    cmd_throttle = clip ? accel_min_throttle : cmd_throttle;
+
+    // BEGIN STEERING LIMITATION SECTION (Limits::limit)
+    cmd_steering = cmd_steering > p.max_steering_angle ? p.max_steering_angle
+                                                       : cmd_steering;
+    cmd_steering = cmd_steering < -p.max_steering_angle
+                   ? -p.max_steering_angle : cmd_steering;
+
+    double cmd_steering_vel = (cmd_steering - cur_steering) / dt;
+    const double vel_max_steering = cur_steering + p.angular_velocity_max*dt;
+    clip = cmd_steering_vel > p.angular_velocity_max;
+    cmd_steering_vel = clip ? p.angular_velocity_max : cmd_steering_vel;
+    cmd_steering = clip ? vel_max_steering : cmd_steering;
+    const double vel_min_steering = cur_steering + p.angular_velocity_min*dt;
+    clip = cmd_steering_vel < p.angular_velocity_min;
+    cmd_steering_vel = clip ? p.angular_velocity_min : cmd_steering_vel;
+    cmd_steering = clip ? vel_min_steering : cmd_steering;
+
+    double steering_accel = (cmd_steering_vel - cur_steering_vel) / dt;
+    const double accel_max_steering = cur_steering + (cur_steering_vel*dt)
+      + .5*p.angular_acceleration_max*dt*dt;
+    clip = steering_accel > p.angular_acceleration_max;
+    steering_accel = clip ? p.angular_acceleration_max : steering_accel;
+    cmd_steering = clip ? accel_max_steering : cmd_steering;
+    const double accel_min_steering = cur_steering + (cur_steering_vel*dt)
+      + .5*p.angular_acceleration_min*dt*dt;
+    clip = steering_accel < p.angular_acceleration_min;
+    cmd_steering = clip ? accel_min_steering : cmd_steering;
+
+    // apply commands (Model::command)
+    throttle[i] = cmd_throttle;
+    speed[i] = throttleToSpeed(p, cmd_throttle);
+    steering_vel[i] = (cmd_steering - cur_steering) / dt;
+    steering[i] = cmd_steering;
+  }
+}
+
+}  // namespace
+
+FleetController::FleetController(const std::shared_ptr<const Params>& params,
+                                 const std::size_t size)
+  : params_(params),
+    size_(size),
+    throttle_out_min_(params->throttle_min - params->throttle_max),
+    throttle_out_max_(params->throttle_max - params->throttle_min),
+    heading_out_min_(-2*params->max_steering_angle),
+    heading_out_max_(2*params->max_steering_angle),
+    current_speed_(size, 0.0),
+    current_heading_(size, 0.0),
+    desired_speed_(size, 0.0),
+    desired_heading_(size, 0.0),
+    current_throttle_(size, 0.0),
+    current_steering_(size, 0.0),
+    current_steering_vel_(size, 0.0),
+    tan_steering_(size, 0.0),
+    throttle_integral_(size, 0.0),
+    throttle_prev_error_(size, 0.0),
+    heading_integral_(size, 0.0),
+    heading_prev_error_(size, 0.0) {
+}
+
+std::size_t FleetController::size() const {
+  return size_;
+}
+
+void FleetController::reset() {
+  for (auto* v : {&current_speed_, &current_heading_,
+                  &desired_speed_, &desired_heading_,
+                  &current_throttle_, &current_steering_,
+                  &current_steering_vel_, &tan_steering_,
+                  &throttle_integral_, &throttle_prev_error_,
+                  &heading_integral_, &heading_prev_error_})
+    std::fill(v->begin(), v->end(), 0.0);
+}
+
+bool FleetController::setState(const std::size_t index,
+                               const double speed,
+                               const double heading) {
+  const double wrapped = wrapAngle(heading);
+  if (!std::isfinite(speed) || std::isnan(wrapped))
+    return false;
+  current_speed_[index] = speed;
+  current_heading_[index] = wrapped;
+  return true;
+}
+
+void FleetController::setStates(const double* speeds,
+                                const double* headings) {
+  for (std::size_t i = 0; i != size_; ++i)
+    setState(i, speeds[i], headings[i]);
+}
+
+void FleetController::getState(const std::size_t index,
+                               double& speed,
+                               double& heading) const {
+  speed = current_speed_[index];
+  heading = current_heading_[index];
+}
+
+bool FleetController::setGoal(const std::size_t index,
+                              const double speed,
+                              const double heading) {
+  const double wrapped = wrapAngle(heading);
+  if (!std::isfinite(speed) || std::isnan(wrapped))
+    return false;
+  desired_speed_[index] = speed;
+  desired_heading_[index] = wrapped;
+  return true;
+}
+
+void FleetController::setGoals(const double* speeds,
+                               const double* headings) {
+  for (std::size_t i = 0; i != size_; ++i)
+    setGoal(i, speeds[i], headings[i]);
+}
+
+void FleetController::getGoal(const std::size_t index,
+                              double& speed,
+                              double& heading) const {
+  speed = desired_speed_[index];
+  heading = desired_heading_[index];
+}
+
+void FleetController::getCommand(const std::size_t index,
+                                 double& throttle,
+                                 double& steering) const {
+  throttle = current_throttle_[index];
+  steering = current_steering_[index];
+}
+
+const double* FleetController::throttles() const {
+  return current_throttle_.data();
+}
+
+const double* FleetController::steerings() const {
+  return current_steering_.data();
+}
+
+void FleetController::getWheelLinVels(double* __restrict left_front,
+                                      double* __restrict right_front,
+                                      double* __restrict left_rear,
+                                      double* __restrict right_rear) const {
+  const double* __restrict speed = current_speed_.data();
+  const double* __restrict tan_steering = tan_steering_.data();
+  const double wheel_base = wheel_base_;
+  const double track_width = track_width_;
+  for (std::size_t i = 0; i < size_; ++i) {
+    const WheelFactors f = wheelFactors(tan_steering[i], wheel_base,
+                                        track_width);
+    // (see Model::getWheelLinVel)
+    const double v = tan_steering[i] != 0 ? std::abs(speed[i]) : speed[i];
+    left_front[i] = v * f.left_front;
+    right_front[i] = v * f.right_front;
+    left_rear[i] = v * f.left_rear;
+    right_rear[i] = v * f.right_rear;
+  }
+}
+
+void FleetController::step(const double dt) {
+  // take one consistent copy of our parameters for the whole fleet
+  FleetParams p;
+  static_cast<ParamsSnapshot&>(p) = params_->snapshot();
+  p.throttle_out_min = throttle_out_min_;
+  p.throttle_out_max = throttle_out_max_;
+  p.heading_out_min = heading_out_min_;
+  p.heading_out_max = heading_out_max_;
+
+  // first pass: pure arithmetic (PID, limits, throttle and steering update)
+  const std::size_t n = size_;
+  controlKernel(p, n, dt,
+                desired_speed_.data(), desired_heading_.data(),
+                current_heading_.data(), current_speed_.data(),
+                current_throttle_.data(), current_steering_.data(),
+                current_steering_vel_.data(),
+                throttle_integral_.data(), throttle_prev_error_.data(),
+                heading_integral_.data(), heading_prev_error_.data());
+
+  // second pass: integrate heading (transcendental; Model::command), and
+  // cache the steering geometry for wheel speed queries
+  for (std::size_t i = 0; i < n; ++i) {
+    tan_steering_[i] = tan(current_steering_[i]);
+    current_heading_[i] += (current_speed_[i]/p.wheel_base)
+      * tan_steering_[i] * dt;
+  }
+  wheel_base_ = p.wheel_base;
+  track_width_ = p.track_width;
+
+  // third pass: bound headings (vectorized)
+  wrapAngles(current_heading_.data(), current_heading_.data(), n);
+}
+
+}  // namespace ackermann
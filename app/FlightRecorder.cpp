@@ -0,0 +1,188 @@
+/* @file FlightRecorder.cpp
+ * @brief Memory-mapped binary recording of Controller inputs and outputs.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <FlightRecorder.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <stdexcept>
+#include <system_error>
+
+namespace ackermann {
+
+namespace {
+
+/**
+* @brief File header; occupies the first record slot of the file.
+*/
+struct FlightHeader {
+  char magic[8];
+  uint32_t version;
+  uint32_t record_size;
+  uint64_t count;
+};
+
+constexpr char kMagic[8] = {'A', 'C', 'K', 'F', 'L', 'I', 'G', 'H'};
+constexpr uint32_t kVersion = 2;
+
+static_assert(sizeof(FlightHeader) <= sizeof(FlightRecord),
+              "header must fit in a single record slot");
+
+#ifdef MAP_POPULATE
+constexpr int kPopulate = MAP_POPULATE;
+#else
+constexpr int kPopulate = 0;
+#endif
+
+[[noreturn]] void throwErrno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+}  // namespace
+
+FlightRecorder::FlightRecorder(const std::string& path,
+                               const std::size_t capacity)
+  : capacity_(capacity) {
+  fd_ = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd_ < 0)
+    throwErrno("unable to create " + path);
+
+  // one slot for our header, followed by our records
+  mapping_size_ = (capacity + 1) * sizeof(FlightRecord);
+  if (::ftruncate(fd_, mapping_size_)) {
+    ::close(fd_);
+    throwErrno("unable to size " + path);
+  }
+  // pre-fault the whole mapping, so recording doesn't take page faults
+  mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | kPopulate, fd_, 0);
+  if (mapping_ == MAP_FAILED) {
+    ::close(fd_);
+    throwErrno("unable to map " + path);
+  }
+
+  FlightHeader header {};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = kVersion;
+  header.record_size = sizeof(FlightRecord);
+  std::memcpy(mapping_, &header, sizeof(header));
+  records_ = static_cast<FlightRecord*>(mapping_) + 1;
+}
+
+FlightRecorder::~FlightRecorder() {
+  // record our final size, and discard any unused space
+  const std::size_t count = size();
+  FlightHeader* header = static_cast<FlightHeader*>(mapping_);
+  header->count = count;
+  ::munmap(mapping_, mapping_size_);
+  // (if this fails the unused slots are simply left Empty)
+  if (::ftruncate(fd_, (count + 1) * sizeof(FlightRecord))) {}
+  ::close(fd_);
+}
+
+void FlightRecorder::recordState(const StateSample& state) {
+  append(FlightRecord::State, &state, sizeof(state));
+}
+
+void FlightRecorder::recordGoal(const GoalSample& goal) {
+  append(FlightRecord::Goal, &goal, sizeof(goal));
+}
+
+void FlightRecorder::recordReset() {
+  append(FlightRecord::Reset, nullptr, 0);
+}
+
+void FlightRecorder::recordParams(const ParamsSnapshot& params) {
+  append(FlightRecord::Params, &params, sizeof(params));
+}
+
+void FlightRecorder::recordTick(const TelemetryRecord& telemetry,
+                                const double dt) {
+  append(FlightRecord::Tick, &telemetry, sizeof(telemetry), dt);
+}
+
+std::size_t FlightRecorder::size() const {
+  const uint64_t next = next_.load(std::memory_order_relaxed);
+  return next < capacity_ ? next : capacity_;
+}
+
+uint64_t FlightRecorder::dropped() const {
+  return dropped_.load(std::memory_order_relaxed);
+}
+
+void FlightRecorder::append(const uint32_t type,
+                            const void* payload,
+                            const std::size_t size,
+                            const double dt) {
+  const uint64_t index = next_.fetch_add(1, std::memory_order_relaxed);
+  if (index >= capacity_) {
+    dropped_.fetch_add(1, std::memory_order_relaxed);
+    return;
+  }
+  FlightRecord& record = records_[index];
+  record.dt = dt;
+  if (size)
+    std::memcpy(record.payload, payload, size);
+  // the type marks the record as complete, so it is written last
+  std::atomic_thread_fence(std::memory_order_release);
+  record.type = type;
+}
+
+FlightLog::FlightLog(const std::string& path) {
+  const int fd = ::open(path.c_str(), O_RDONLY);
+  if (fd < 0)
+    throwErrno("unable to open " + path);
+  struct stat info;
+  if (::fstat(fd, &info)) {
+    ::close(fd);
+    throwErrno("unable to stat " + path);
+  }
+  mapping_size_ = static_cast<std::size_t>(info.st_size);
+  if (mapping_size_ < sizeof(FlightRecord)) {
+    ::close(fd);
+    throw std::runtime_error(path + " is not a flight recording");
+  }
+  mapping_ = ::mmap(nullptr, mapping_size_, PROT_READ, MAP_PRIVATE, fd, 0);
+  ::close(fd);
+  if (mapping_ == MAP_FAILED)
+    throwErrno("unable to map " + path);
+
+  const FlightHeader* header = static_cast<const FlightHeader*>(mapping_);
+  if (std::memcmp(header->magic, kMagic, sizeof(kMagic))
+      || header->version != kVersion
+      || header->record_size != sizeof(FlightRecord)) {
+    ::munmap(mapping_, mapping_size_);
+    throw std::runtime_error(path + " is not a compatible flight recording");
+  }
+  records_ = static_cast<const FlightRecord*>(mapping_) + 1;
+  // an unfinished recording has no count; use every slot (unused slots are
+  // Empty)
+  size_ = mapping_size_ / sizeof(FlightRecord) - 1;
+  if (header->count && header->count < size_)
+    size_ = header->count;
+}
+
+FlightLog::~FlightLog() {
+  ::munmap(mapping_, mapping_size_);
+}
+
+std::size_t FlightLog::size() const {
+  return size_;
+}
+
+const FlightRecord& FlightLog::operator[](const std::size_t index) const {
+  return records_[index];
+}
+
+}  // namespace ackermann
@@ -0,0 +1,76 @@
+/* @file Notifier.cpp
+ * @brief Linux futex implementation of the Notifier event.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <Notifier.hpp>
+
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <climits>
+
+namespace ackermann {
+
+namespace {
+
+static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t)
+              && ATOMIC_INT_LOCK_FREE == 2,
+              "futex words must be plain lock free integers");
+
+long futex(std::atomic<uint32_t>* word, const int op, const uint32_t value,
+           const struct timespec* timeout) {
+  return syscall(SYS_futex, reinterpret_cast<uint32_t*>(word), op, value,
+                 timeout, nullptr, 0);
+}
+
+}  // namespace
+
+uint32_t Notifier::value() const {
+  return value_.load(std::memory_order_acquire);
+}
+
+void Notifier::notify() {
+  // both of these are sequentially consistent: either we observe a waiter,
+  // or the waiter (whose futex call rechecks the value) observes our change
+  value_.fetch_add(1);
+  if (waiters_.load())
+    futex(&value_, shared_ ? FUTEX_WAKE : FUTEX_WAKE_PRIVATE, INT_MAX,
+          nullptr);
+}
+
+bool Notifier::wait(const uint32_t last,
+                    const Clock::time_point deadline) const {
+  waiters_.fetch_add(1);
+  bool changed = true;
+  while (value_.load() == last) {
+    struct timespec timeout;
+    const struct timespec* timeout_ptr = nullptr;
+    if (deadline != Clock::time_point::max()) {
+      const auto now = Clock::now();
+      if (now >= deadline) {
+        changed = false;
+        break;
+      }
+      const auto remaining = std::chrono::duration_cast<
+        std::chrono::nanoseconds>(deadline - now).count();
+      timeout.tv_sec = remaining / 1000000000;
+      timeout.tv_nsec = remaining % 1000000000;
+      timeout_ptr = &timeout;
+    }
+    // returns on a wake up, a timeout, a signal or if the value changed
+    futex(&value_, shared_ ? FUTEX_WAIT : FUTEX_WAIT_PRIVATE, last,
+          timeout_ptr);
+  }
+  waiters_.fetch_sub(1);
+  return changed;
+}
+
+}  // namespace ackermann
@@ -0,0 +1,90 @@
+/* @file PlotBuffer.cpp
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <PlotBuffer.hpp>
+
+#include <algorithm>
+
+namespace ackermann {
+
+namespace {
+
+std::size_t divideCeil(const std::size_t a, const std::size_t b) {
+  return (a + b - 1) / b;
+}
+
+}  // namespace
+
+PlotBuffer::PlotBuffer(const std::size_t samples,
+                       const std::size_t max_points)
+  : decimation_(samples <= max_points
+                ? 1 : divideCeil(2 * samples, std::max<std::size_t>(
+                                                max_points, 2))) {
+  // each bucket of several samples is stored as two points
+  const std::size_t capacity = std::max<std::size_t>(
+    decimation_ == 1 ? samples : 2 * divideCeil(samples, decimation_), 1);
+  times_.resize(capacity);
+  values_.resize(capacity);
+}
+
+void PlotBuffer::append(const double time, const double value) {
+  if (decimation_ == 1) {
+    push(time, value);
+    return;
+  }
+
+  // accumulate the current bucket (preferring the earliest minimum and the
+  // latest maximum, so a flat bucket spans its whole duration)
+  if (!pending_ || value < min_value_) {
+    min_time_ = time;
+    min_value_ = value;
+  }
+  if (!pending_ || value >= max_value_) {
+    max_time_ = time;
+    max_value_ = value;
+  }
+  if (++pending_ == decimation_) {
+    const bool min_first = min_time_ <= max_time_;
+    push(min_first ? min_time_ : max_time_,
+         min_first ? min_value_ : max_value_);
+    push(min_first ? max_time_ : min_time_,
+         min_first ? max_value_ : min_value_);
+    pending_ = 0;
+  }
+}
+
+void PlotBuffer::clear() {
+  head_ = 0;
+  size_ = 0;
+  pending_ = 0;
+}
+
+std::size_t PlotBuffer::size() const {
+  return size_ + std::min<std::size_t>(pending_, 2);
+}
+
+std::size_t PlotBuffer::decimation() const {
+  return decimation_;
+}
+
+void PlotBuffer::range(double& min, double& max) const {
+  forEach([&min, &max](double, const double value) {
+    min = std::min(min, value);
+    max = std::max(max, value);
+  });
+}
+
+void PlotBuffer::push(const double time, const double value) {
+  times_[head_] = time;
+  values_[head_] = value;
+  head_ = (head_ + 1) % times_.size();
+  size_ = std::min(size_ + 1, times_.size());
+}
+
+}  // namespace ackermann
@@ -0,0 +1,121 @@
+/* @file Realtime.cpp
+ * @brief Application of real-time execution options on POSIX systems.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <Realtime.hpp>
+
+#include <alloca.h>
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+
+#include <algorithm>
+#include <cerrno>
+
+namespace ackermann {
+
+namespace {
+
+constexpr std::size_t kStackPage = 4096;
+
+// stack left untouched below the pre-faulted region: room for the guard
+// page and for the frames of the control loop's callees
+constexpr std::size_t kStackMargin = 64 * 1024;
+
+// return the number of bytes of stack below the caller's frame
+std::size_t availableStack() {
+  const char* const frame =
+    static_cast<const char*>(__builtin_frame_address(0));
+#ifdef __linux__
+  pthread_attr_t attr;
+  if (!pthread_getattr_np(pthread_self(), &attr)) {
+    void* base;
+    std::size_t size;
+    const int error = pthread_attr_getstack(&attr, &base, &size);
+    pthread_attr_destroy(&attr);
+    if (!error && frame > static_cast<const char*>(base))
+      return frame - static_cast<const char*>(base);
+  }
+#endif
+  // (fall back to the limit, ignoring the stack already in use)
+  rlimit limit;
+  if (!getrlimit(RLIMIT_STACK, &limit) && limit.rlim_cur != RLIM_INFINITY)
+    return limit.rlim_cur;
+  return 0;
+}
+
+// touch (and therefore fault in) up to the given number of bytes of stack,
+// clamped to the stack available; return the number of bytes touched
+__attribute__((noinline))
+std::size_t prefaultStack(const std::size_t bytes) {
+  const std::size_t available = availableStack();
+  const std::size_t clamped = std::min(
+    bytes, available > kStackMargin ? available - kStackMargin : 0);
+  volatile unsigned char* const stack =
+    static_cast<volatile unsigned char*>(alloca(clamped));
+  for (std::size_t i = 0; i < clamped; i += kStackPage)
+    stack[i] = 0;
+  return clamped;
+}
+
+int applyScheduler(const RealtimeOptions& options) {
+  int policy;
+  switch (options.policy) {
+    case RealtimeOptions::Policy::Fifo:
+      policy = SCHED_FIFO;
+      break;
+    case RealtimeOptions::Policy::RoundRobin:
+      policy = SCHED_RR;
+      break;
+    default:
+      return 0;
+  }
+  sched_param param {};
+  param.sched_priority = options.priority;
+  return pthread_setschedparam(pthread_self(), policy, &param);
+}
+
+int applyAffinity(const RealtimeOptions& options) {
+  if (options.cpus.empty())
+    return 0;
+#ifdef __linux__
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (const int cpu : options.cpus) {
+    if (cpu < 0 || cpu >= CPU_SETSIZE)
+      return EINVAL;
+    CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+  return ENOTSUP;
+#endif
+}
+
+int applyLockMemory(const RealtimeOptions& options) {
+  if (!options.lock_memory)
+    return 0;
+  return mlockall(MCL_CURRENT | MCL_FUTURE) ? errno : 0;
+}
+
+}  // namespace
+
+RealtimeStatus applyRealtimeOptions(const RealtimeOptions& options) {
+  RealtimeStatus status;
+  status.scheduler_error = applyScheduler(options);
+  status.affinity_error = applyAffinity(options);
+  // lock memory before pre-faulting, so that the touched stack stays resident
+  status.lock_memory_error = applyLockMemory(options);
+  if (options.prefault_stack)
+    status.stack_prefaulted = prefaultStack(options.prefault_stack);
+  return status;
+}
+
+}  // namespace ackermann
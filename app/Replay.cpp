@@ -0,0 +1,112 @@
+/* @file Replay.cpp
+ * @brief Offline replay of flight recordings through a fresh Controller.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <Replay.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+
+#include <Controller.hpp>
+
+namespace ackermann {
+
+namespace {
+
+// return the largest absolute difference between two iterations' outputs
+double difference(const TelemetryRecord& a, const TelemetryRecord& b) {
+  const double pairs[][2] = {
+    {a.throttle_terms.p, b.throttle_terms.p},
+    {a.throttle_terms.i, b.throttle_terms.i},
+    {a.throttle_terms.d, b.throttle_terms.d},
+    {a.heading_terms.p, b.heading_terms.p},
+    {a.heading_terms.i, b.heading_terms.i},
+    {a.heading_terms.d, b.heading_terms.d},
+    {a.throttle, b.throttle},
+    {a.steering, b.steering},
+    {a.steering_vel, b.steering_vel},
+    {a.wheel_left_front, b.wheel_left_front},
+    {a.wheel_right_front, b.wheel_right_front},
+    {a.wheel_left_rear, b.wheel_left_rear},
+    {a.wheel_right_rear, b.wheel_right_rear}};
+  double result = 0.0;
+  for (const auto& pair : pairs) {
+    // identical values (including infinities) never differ
+    if (pair[0] == pair[1])
+      continue;
+    const double error = std::abs(pair[0] - pair[1]);
+    result = std::isnan(error) ? INFINITY : std::max(result, error);
+  }
+  return result;
+}
+
+}  // namespace
+
+ReplayResult replay(const FlightLog& log, const double tolerance) {
+  ReplayResult result;
+  std::shared_ptr<Params> params;
+  std::unique_ptr<Controller> controller;
+
+  for (std::size_t i = 0; i != log.size(); ++i) {
+    const FlightRecord& record = log[i];
+    switch (record.type) {
+      case FlightRecord::State:
+      case FlightRecord::Goal:
+        // (each recorded iteration carries the inputs it actually consumed)
+        ++result.inputs;
+        break;
+      case FlightRecord::Reset:
+        if (controller)
+          controller->reset();
+        break;
+      case FlightRecord::Params: {
+        const ParamsSnapshot snapshot = record.get<ParamsSnapshot>();
+        if (!params) {
+          // construct our pipeline with the initial parameters
+          params = std::make_shared<Params>(0.0, 0.0, 0.0, 0.0, 0.0);
+          params->restore(snapshot);
+          // (each iteration's telemetry is drained straight away)
+          controller = std::make_unique<Controller>(params, 1);
+        } else {
+          params->restore(snapshot);
+        }
+        break;
+      }
+      case FlightRecord::Tick: {
+        if (!controller)
+          break;
+        const TelemetryRecord expected = record.get<TelemetryRecord>();
+        controller->setState(expected.state);
+        controller->setGoal(expected.goal);
+        // (the trajectory isn't recorded, so neither is it replayed; its
+        // setpoint is the recorded goal, and its feed-forward is recorded)
+        controller->step(record.dt, expected.stamp,
+                         expected.throttle_feed_forward,
+                         expected.steering_feed_forward);
+
+        TelemetryRecord actual;
+        controller->drainTelemetry(&actual, 1);
+        const double error = difference(expected, actual);
+        result.max_error = std::max(result.max_error, error);
+        if (error > tolerance) {
+          if (!result.divergent_ticks++)
+            result.first_divergence = expected.tick;
+        }
+        ++result.ticks;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+  return result;
+}
+
+}  // namespace ackermann
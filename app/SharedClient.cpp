@@ -0,0 +1,107 @@
+/* @file SharedClient.cpp
+ * @brief Client side of the shared memory Controller interface.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <SharedMemory.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+#include <system_error>
+
+namespace ackermann {
+
+constexpr char SharedBlock::kMagic[8];
+constexpr uint32_t SharedBlock::kVersion;
+
+namespace {
+
+[[noreturn]] void throwErrno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+}  // namespace
+
+SharedClient::SharedClient(const std::string& name) {
+  const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+  if (fd < 0)
+    throwErrno("unable to open " + name);
+  struct stat status;
+  if (::fstat(fd, &status)) {
+    ::close(fd);
+    throwErrno("unable to stat " + name);
+  }
+  if (static_cast<std::size_t>(status.st_size) != sizeof(SharedBlock)) {
+    ::close(fd);
+    throw std::runtime_error(name + " is not a compatible segment");
+  }
+  void* mapping = ::mmap(nullptr, sizeof(SharedBlock), PROT_READ | PROT_WRITE,
+                         MAP_SHARED, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED)
+    throwErrno("unable to map " + name);
+
+  // the version is published last, once the server has initialized all else
+  block_ = static_cast<SharedBlock*>(mapping);
+  if (block_->version.load(std::memory_order_acquire) != SharedBlock::kVersion
+      || std::memcmp(block_->magic, SharedBlock::kMagic,
+                     sizeof(SharedBlock::kMagic))
+      || block_->size != sizeof(SharedBlock)) {
+    ::munmap(mapping, sizeof(SharedBlock));
+    throw std::runtime_error(name + " is not a compatible segment");
+  }
+}
+
+SharedClient::~SharedClient() {
+  ::munmap(block_, sizeof(SharedBlock));
+}
+
+bool SharedClient::setState(const StateSample& state) {
+  if (!std::isfinite(state.speed) || !std::isfinite(state.heading))
+    return false;
+  block_->state.store(state);
+  return true;
+}
+
+bool SharedClient::setGoal(const GoalSample& goal) {
+  if (!std::isfinite(goal.speed) || !std::isfinite(goal.heading))
+    return false;
+  block_->goal.store(goal);
+  return true;
+}
+
+void SharedClient::getCommand(CommandSample& command) const {
+  command = block_->command.load();
+}
+
+bool SharedClient::waitForCommand(const uint64_t after,
+                                  CommandSample& command,
+                                  const Clock::duration timeout) const {
+  const Clock::time_point deadline = timeout == Clock::duration::max()
+    ? Clock::time_point::max() : Clock::now() + timeout;
+  while (true) {
+    // (as Controller::waitForCommand)
+    const uint32_t event = block_->command_event.value();
+    command = block_->command.load();
+    if (command.sequence > after)
+      return true;
+    if (!block_->command_event.wait(event, deadline)) {
+      command = block_->command.load();
+      return command.sequence > after;
+    }
+  }
+}
+
+}  // namespace ackermann
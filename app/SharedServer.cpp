@@ -0,0 +1,116 @@
+/* @file SharedServer.cpp
+ * @brief Controller side of the shared memory Controller interface.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <SharedMemory.hpp>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <system_error>
+
+#include <Controller.hpp>
+
+namespace ackermann {
+
+namespace {
+
+#ifdef MAP_POPULATE
+constexpr int kPopulate = MAP_POPULATE;
+#else
+constexpr int kPopulate = 0;
+#endif
+
+// reads of an input being written, before waiting for the next iteration
+constexpr unsigned kReadAttempts = 16;
+
+[[noreturn]] void throwErrno(const std::string& what) {
+  throw std::system_error(errno, std::generic_category(), what);
+}
+
+}  // namespace
+
+SharedServer::SharedServer(Controller& controller, const std::string& name)
+  : controller_(controller), name_(name) {
+  const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (fd < 0)
+    throwErrno("unable to create " + name);
+  if (::ftruncate(fd, sizeof(SharedBlock))) {
+    ::close(fd);
+    ::shm_unlink(name.c_str());
+    throwErrno("unable to size " + name);
+  }
+  // pre-fault the mapping, so the control loop doesn't take page faults
+  void* mapping = ::mmap(nullptr, sizeof(SharedBlock), PROT_READ | PROT_WRITE,
+                         MAP_SHARED | kPopulate, fd, 0);
+  ::close(fd);
+  if (mapping == MAP_FAILED) {
+    ::shm_unlink(name.c_str());
+    throwErrno("unable to map " + name);
+  }
+
+  // initialize everything, then publish the version to admit clients
+  block_ = new (mapping) SharedBlock();
+  std::memcpy(block_->magic, SharedBlock::kMagic, sizeof(SharedBlock::kMagic));
+  block_->size = sizeof(SharedBlock);
+  state_version_ = block_->state.version();
+  goal_version_ = block_->goal.version();
+  block_->version.store(SharedBlock::kVersion, std::memory_order_release);
+
+  subscription_ = controller_.subscribe([this](const CommandSample& command){
+    this->update(command);
+  });
+}
+
+SharedServer::~SharedServer() {
+  controller_.unsubscribe(subscription_);
+  block_->~SharedBlock();
+  ::munmap(block_, sizeof(SharedBlock));
+  ::shm_unlink(name_.c_str());
+}
+
+void SharedServer::update(const CommandSample& command) {
+  // publish the command, waking any waiting clients
+  block_->command.store(command);
+  block_->command_event.notify();
+
+  // pass on any new inputs (for the next iteration); never wait on a
+  // client, keeping the previous input until the write completes
+  const uint64_t state_version = block_->state.version();
+  if (state_version != state_version_) {
+    StateSample state;
+    if (block_->state.tryLoad(state, kReadAttempts)) {
+      state_version_ = state_version;
+      controller_.setState(state);
+    } else {
+      missed_reads_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  const uint64_t goal_version = block_->goal.version();
+  if (goal_version != goal_version_) {
+    GoalSample goal;
+    if (block_->goal.tryLoad(goal, kReadAttempts)) {
+      goal_version_ = goal_version;
+      controller_.setGoal(goal);
+    } else {
+      missed_reads_.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+}
+
+uint64_t SharedServer::missedReads() const {
+  return missed_reads_.load(std::memory_order_relaxed);
+}
+
+}  // namespace ackermann
@@ -0,0 +1,241 @@
+/* @file Simulation.cpp
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <Simulation.hpp>
+#include <Controller.hpp>
+#include <fake/noise.h>
+#include <fake/plant.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+
+namespace ackermann {
+
+namespace {
+
+/**
+* @brief Reads the values of a single scenario line.
+*/
+class Line {
+ public:
+  Line(const std::string& text, const std::size_t number)
+    : stream_(text), number_(number) {}
+
+  std::string word() {
+    std::string value;
+    if (!(stream_ >> value))
+      fail("missing value");
+    return value;
+  }
+
+  double number() {
+    double value;
+    if (!(stream_ >> value) || !std::isfinite(value))
+      fail("expected a number");
+    return value;
+  }
+
+  double positive() {
+    const double value = number();
+    if (value <= 0)
+      fail("expected a positive number");
+    return value;
+  }
+
+  void end() {
+    std::string extra;
+    if (stream_ >> extra)
+      fail("unexpected '" + extra + "'");
+  }
+
+  [[noreturn]] void fail(const std::string& what) const {
+    throw std::runtime_error("scenario line " + std::to_string(number_)
+                             + ": " + what);
+  }
+
+ private:
+  std::istringstream stream_;
+  const std::size_t number_;
+};
+
+std::unique_ptr<fake::NoiseModel> makeModel(const SensorNoise& sensor) {
+  switch (sensor.model) {
+    case SensorNoise::Model::Bias:
+      return std::make_unique<fake::Bias>(sensor.a);
+    case SensorNoise::Model::RandomWalk:
+      return std::make_unique<fake::RandomWalk>(sensor.a);
+    case SensorNoise::Model::Dropout:
+      return std::make_unique<fake::Dropout>(sensor.a);
+    case SensorNoise::Model::White:
+    default:
+      return std::make_unique<fake::WhiteNoise>(sensor.a, sensor.b);
+  }
+}
+
+}  // namespace
+
+Scenario parseScenario(std::istream& in) {
+  Scenario scenario;
+  std::string text;
+  for (std::size_t number = 1; std::getline(in, text); ++number) {
+    // strip comments, and skip empty lines
+    text = text.substr(0, text.find('#'));
+    if (text.find_first_not_of(" \t\r") == std::string::npos)
+      continue;
+
+    Line line(text, number);
+    const std::string keyword = line.word();
+    if (keyword == "duration") {
+      scenario.duration = line.positive();
+    } else if (keyword == "dt") {
+      scenario.dt = line.positive();
+    } else if (keyword == "vehicle") {
+      scenario.wheel_base = line.positive();
+      scenario.track_width = line.positive();
+      scenario.max_steering_angle = line.positive();
+    } else if (keyword == "speed_gains" || keyword == "heading_gains") {
+      PIDGains& gains = keyword == "speed_gains" ? scenario.pid_speed
+                                                 : scenario.pid_heading;
+      gains.kp = line.number();
+      gains.ki = line.number();
+      gains.kd = line.number();
+    } else if (keyword == "initial") {
+      scenario.initial_speed = line.number();
+      scenario.initial_heading = line.number();
+    } else if (keyword == "setpoint") {
+      Setpoint setpoint;
+      setpoint.time = line.number();
+      setpoint.speed = line.number();
+      setpoint.heading = line.number();
+      if (!scenario.setpoints.empty()
+          && setpoint.time < scenario.setpoints.back().time)
+        line.fail("setpoints must be in time order");
+      scenario.setpoints.push_back(setpoint);
+    } else if (keyword == "noise") {
+      scenario.noise_mean = line.number();
+      scenario.noise_stddev = line.number();
+    } else if (keyword == "seed") {
+      scenario.seed = static_cast<uint64_t>(line.number());
+    } else if (keyword == "lag") {
+      scenario.throttle_lag = line.number();
+      scenario.steering_lag = line.number();
+    } else if (keyword == "substeps") {
+      scenario.substeps = static_cast<unsigned int>(line.positive());
+    } else if (keyword == "sensor") {
+      SensorNoise sensor;
+      const std::string signal = line.word();
+      if (signal != "speed" && signal != "heading")
+        line.fail("unknown signal '" + signal + "'");
+      sensor.heading = signal == "heading";
+      const std::string model = line.word();
+      if (model == "white") {
+        sensor.model = SensorNoise::Model::White;
+        sensor.a = line.number();
+        sensor.b = line.number();
+      } else if (model == "bias") {
+        sensor.model = SensorNoise::Model::Bias;
+        sensor.a = line.number();
+      } else if (model == "walk") {
+        sensor.model = SensorNoise::Model::RandomWalk;
+        sensor.a = line.number();
+      } else if (model == "dropout") {
+        sensor.model = SensorNoise::Model::Dropout;
+        sensor.a = line.number();
+      } else {
+        line.fail("unknown noise model '" + model + "'");
+      }
+      scenario.sensors.push_back(sensor);
+    } else {
+      line.fail("unknown keyword '" + keyword + "'");
+    }
+    line.end();
+  }
+  return scenario;
+}
+
+void simulate(const Scenario& scenario,
+              const std::function<void(const SimulationSample&)>& sink,
+              const double speedup) {
+  auto params = std::make_shared<Params>(scenario.wheel_base,
+                                         scenario.track_width,
+                                         scenario.max_steering_angle,
+                                         scenario.pid_speed.kp,
+                                         scenario.pid_heading.kp);
+  params->update([&scenario](Params& p) {
+    p.control_frequency = 1 / scenario.dt;
+    p.pid_speed->ki = scenario.pid_speed.ki;
+    p.pid_speed->kd = scenario.pid_speed.kd;
+    p.pid_heading->ki = scenario.pid_heading.ki;
+    p.pid_heading->kd = scenario.pid_heading.kd;
+  });
+
+  fake::PlantOptions options(scenario.wheel_base,
+                             scenario.max_steering_angle);
+  options.noise_mean = scenario.noise_mean;
+  options.noise_stddev = scenario.noise_stddev;
+  options.noise_seed = scenario.seed;
+  options.throttle_time_constant = scenario.throttle_lag;
+  options.steering_time_constant = scenario.steering_lag;
+  options.substeps = scenario.substeps;
+  fake::Plant plant(options, params);
+  for (const SensorNoise& sensor : scenario.sensors)
+    plant.addSensorNoise(sensor.heading ? fake::Plant::Signal::Heading
+                                        : fake::Plant::Signal::Speed,
+                         makeModel(sensor));
+  plant.setState(scenario.initial_speed, scenario.initial_heading);
+
+  Controller controller(params);
+  SimulationSample sample;
+  sample.goal_speed = 0.0;
+  sample.goal_heading = 0.0;
+  std::size_t next_setpoint = 0;
+  const auto start = std::chrono::steady_clock::now();
+  const uint64_t ticks = std::llround(scenario.duration / scenario.dt);
+  for (uint64_t tick = 0; tick != ticks; ++tick) {
+    // apply any setpoints which have become active (everything is stamped
+    // in simulated time, so that runs are reproducible)
+    const double time = tick * scenario.dt;
+    const Clock::time_point now = Clock::time_point()
+      + std::chrono::duration_cast<Clock::duration>(
+          std::chrono::duration<double>(time));
+    while (next_setpoint != scenario.setpoints.size()
+           && scenario.setpoints[next_setpoint].time <= time) {
+      sample.goal_speed = scenario.setpoints[next_setpoint].speed;
+      sample.goal_heading = scenario.setpoints[next_setpoint].heading;
+      controller.setGoal({sample.goal_speed, sample.goal_heading, now});
+      ++next_setpoint;
+    }
+
+    // close the loop through our (noisy) sensors
+    double speed, heading;
+    plant.getMeasurement(speed, heading);
+    controller.setState({speed, heading, now});
+    controller.step(scenario.dt, now);
+    controller.getCommand(sample.throttle, sample.steering);
+    plant.command(sample.throttle, sample.steering, scenario.dt);
+
+    sample.tick = tick;
+    sample.time = (tick + 1) * scenario.dt;
+    plant.getState(sample.speed, sample.heading);
+    plant.getMeasurement(sample.measured_speed, sample.measured_heading);
+    sink(sample);
+
+    // optionally pace ourselves relative to the wall clock
+    if (speedup > 0)
+      std::this_thread::sleep_until(start + std::chrono::duration_cast<
+        std::chrono::steady_clock::duration>(
+          std::chrono::duration<double>(sample.time / speedup)));
+  }
+}
+
+}  // namespace ackermann
@@ -0,0 +1,144 @@
+/* @file StageProfiler.cpp
+ * @brief Lock-free per-stage profiling of the control loop pipeline.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <StageProfiler.hpp>
+
+namespace ackermann {
+
+constexpr std::size_t StageProfiler::kStages;
+
+namespace {
+
+uint64_t nanoseconds(const std::chrono::steady_clock::duration d) {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(d).count();
+}
+
+}  // namespace
+
+const char* stageName(const Stage stage) {
+  switch (stage) {
+    case Stage::Inputs: return "inputs";
+    case Stage::PID: return "pid";
+    case Stage::Limits: return "limits";
+    case Stage::Model: return "model";
+    case Stage::Publish: return "publish";
+    case Stage::Telemetry: return "telemetry";
+    default: return "unknown";
+  }
+}
+
+void StageProfiler::begin(const uint64_t tick) {
+  current_.tick = tick;
+  current_.start = std::chrono::steady_clock::now();
+  last_ = current_.start;
+}
+
+void StageProfiler::mark(const Stage stage) {
+  const auto now = std::chrono::steady_clock::now();
+  const uint64_t duration = nanoseconds(now - last_);
+  last_ = now;
+  current_.end[static_cast<std::size_t>(stage)] =
+    nanoseconds(now - current_.start);
+
+  // (there is a single writer, so no compare and exchange is required)
+  Accumulator& accumulator = stages_[static_cast<std::size_t>(stage)];
+  accumulator.durations.record(duration);
+  accumulator.total.fetch_add(duration, std::memory_order_relaxed);
+  if (duration < accumulator.min.load(std::memory_order_relaxed))
+    accumulator.min.store(duration, std::memory_order_relaxed);
+  if (duration > accumulator.max.load(std::memory_order_relaxed))
+    accumulator.max.store(duration, std::memory_order_relaxed);
+  accumulator.count.fetch_add(1, std::memory_order_release);
+}
+
+void StageProfiler::end() {
+  traces_.push(current_);
+}
+
+StageStats StageProfiler::stats(const Stage stage) const {
+  const Accumulator& accumulator = stages_[static_cast<std::size_t>(stage)];
+  StageStats result;
+  result.count = accumulator.count.load(std::memory_order_acquire);
+  if (!result.count)
+    return result;
+  result.min = accumulator.min.load(std::memory_order_relaxed);
+  result.max = accumulator.max.load(std::memory_order_relaxed);
+  result.mean = static_cast<double>(
+    accumulator.total.load(std::memory_order_relaxed)) / result.count;
+  result.durations = accumulator.durations.snapshot();
+  return result;
+}
+
+void StageProfiler::reset() {
+  for (Accumulator& accumulator : stages_) {
+    accumulator.count = 0;
+    accumulator.total = 0;
+    accumulator.min = UINT64_MAX;
+    accumulator.max = 0;
+    accumulator.durations.reset();
+  }
+}
+
+std::size_t StageProfiler::drainTrace(StageTrace* traces,
+                                      const std::size_t max) {
+  return traces_.drain(traces, max);
+}
+
+uint64_t StageProfiler::traceDropped() const {
+  return traces_.dropped();
+}
+
+void writeChromeTrace(std::ostream& out,
+                      const StageTrace* traces,
+                      const std::size_t count) {
+  // complete ("X") events, timestamped in microseconds
+  const auto event = [&out](const char* name, const uint64_t tick,
+                            const double start, const double duration) {
+    out << "{\"name\":\"" << name << "\",\"cat\":\"controller\","
+        << "\"ph\":\"X\",\"pid\":1,\"tid\":1,\"ts\":" << start
+        << ",\"dur\":" << duration << ",\"args\":{\"tick\":" << tick << "}}";
+  };
+
+  const auto precision = out.precision(15);
+  out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  for (std::size_t i = 0; i != count; ++i) {
+    const StageTrace& trace = traces[i];
+    const double start = 1e-3 * nanoseconds(trace.start.time_since_epoch());
+    const uint64_t total = trace.end[StageProfiler::kStages - 1];
+    out << (i ? ",\n" : "\n");
+    event("tick", trace.tick, start, 1e-3 * total);
+    uint64_t begin = 0;
+    for (std::size_t s = 0; s != StageProfiler::kStages; ++s) {
+      out << ",\n";
+      event(stageName(static_cast<Stage>(s)), trace.tick,
+            start + 1e-3 * begin, 1e-3 * (trace.end[s] - begin));
+      begin = trace.end[s];
+    }
+  }
+  out << "\n]}\n";
+  out.precision(precision);
+}
+
+std::ostream& operator<<(std::ostream& out, const StageProfiler& profiler) {
+  for (std::size_t s = 0; s != StageProfiler::kStages; ++s) {
+    const Stage stage = static_cast<Stage>(s);
+    const StageStats stats = profiler.stats(stage);
+    out << (s ? "\n" : "") << stageName(stage) << ": "
+        << stats.count << " samples, min/mean/max "
+        << stats.min << "/" << stats.mean << "/" << stats.max
+        << "ns; p50/p99/p999 "
+        << stats.durations.percentile(0.5) << "/"
+        << stats.durations.percentile(0.99) << "/"
+        << stats.durations.percentile(0.999) << "ns";
+  }
+  return out;
+}
+
+}  // namespace ackermann
@@ -0,0 +1,162 @@
+/* @file TimingStats.cpp
+ * @brief Lock-free instrumentation of control loop timing.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <TimingStats.hpp>
+
+#include <cmath>
+#include <utility>
+
+namespace ackermann {
+
+uint64_t Histogram::Snapshot::count() const {
+  uint64_t total = 0;
+  for (const uint64_t c : counts)
+    total += c;
+  return total;
+}
+
+uint64_t Histogram::Snapshot::percentile(const double quantile) const {
+  const uint64_t total = count();
+  if (!total)
+    return 0;
+  // rank of the requested value (1 based)
+  const double clamped = std::fmin(std::fmax(quantile, 0.0), 1.0);
+  uint64_t rank = static_cast<uint64_t>(std::ceil(clamped * total));
+  rank = rank ? rank : 1;
+
+  uint64_t seen = 0;
+  for (std::size_t i = 0; i != kBuckets; ++i) {
+    seen += counts[i];
+    if (seen >= rank)
+      return bucketValue(i);
+  }
+  return max();
+}
+
+uint64_t Histogram::Snapshot::max() const {
+  for (std::size_t i = kBuckets; i != 0; --i)
+    if (counts[i - 1])
+      return bucketValue(i - 1);
+  return 0;
+}
+
+double Histogram::Snapshot::mean() const {
+  const uint64_t total = count();
+  if (!total)
+    return 0.0;
+  double sum = 0.0;
+  for (std::size_t i = 0; i != kBuckets; ++i)
+    sum += static_cast<double>(counts[i]) * bucketValue(i);
+  return sum / total;
+}
+
+Histogram::Snapshot Histogram::snapshot() const {
+  Snapshot result;
+  for (std::size_t i = 0; i != kBuckets; ++i)
+    result.counts[i] = counts_[i].load(std::memory_order_relaxed);
+  return result;
+}
+
+void Histogram::reset() {
+  for (auto& count : counts_)
+    count.store(0, std::memory_order_relaxed);
+}
+
+uint64_t Histogram::bucketValue(const std::size_t bucket) {
+  if (bucket < kSubBuckets)
+    return bucket;
+  const unsigned shift = (bucket >> kSubBucketBits) - 1;
+  const uint64_t sub = (bucket & (kSubBuckets - 1)) + kSubBuckets;
+  // (wraps to the largest value for the final bucket)
+  return ((sub + 1) << shift) - 1;
+}
+
+void TimingRecorder::record(const uint64_t period,
+                            const uint64_t compute,
+                            const uint64_t lateness,
+                            const bool overrun,
+                            const uint64_t missed) {
+  if (period)
+    period_.record(period);
+  compute_.record(compute);
+  if (overrun)
+    overruns_.fetch_add(1, std::memory_order_relaxed);
+  if (missed)
+    missed_ticks_.fetch_add(missed, std::memory_order_relaxed);
+  // (there is a single writer, so no compare and exchange is required)
+  if (lateness > max_lateness_.load(std::memory_order_relaxed))
+    max_lateness_.store(lateness, std::memory_order_relaxed);
+  iterations_.fetch_add(1, std::memory_order_release);
+}
+
+TimingStats TimingRecorder::stats() const {
+  TimingStats result;
+  result.iterations = iterations_.load(std::memory_order_acquire);
+  result.overruns = overruns_.load(std::memory_order_relaxed);
+  result.missed_ticks = missed_ticks_.load(std::memory_order_relaxed);
+  result.max_lateness = max_lateness_.load(std::memory_order_relaxed);
+  result.period = period_.snapshot();
+  result.compute = compute_.snapshot();
+  return result;
+}
+
+void TimingRecorder::reset() {
+  iterations_ = 0;
+  overruns_ = 0;
+  missed_ticks_ = 0;
+  max_lateness_ = 0;
+  period_.reset();
+  compute_.reset();
+}
+
+TimingLogger::TimingLogger(std::function<TimingStats()> source,
+                           std::ostream& out,
+                           const std::chrono::milliseconds interval)
+  : source_(std::move(source)), out_(out), interval_(interval) {
+  handle_ = std::thread([this](){this->loop();});
+}
+
+TimingLogger::~TimingLogger() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    cancel_ = true;
+  }
+  wake_.notify_all();
+  handle_.join();
+}
+
+void TimingLogger::loop() {
+  uint64_t overruns = 0;
+  uint64_t missed_ticks = 0;
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (!wake_.wait_for(lock, interval_, [this](){return cancel_;})) {
+    const TimingStats stats = source_();
+    if (stats.overruns != overruns || stats.missed_ticks != missed_ticks)
+      out_ << "Loop timing violation: " << stats << std::endl;
+    overruns = stats.overruns;
+    missed_ticks = stats.missed_ticks;
+  }
+}
+
+std::ostream& operator<<(std::ostream& out, const TimingStats& stats) {
+  out << stats.iterations << " iterations, "
+      << stats.overruns << " overruns, "
+      << stats.missed_ticks << " missed ticks, max lateness "
+      << stats.max_lateness / 1000 << "us; period p50/p99/max "
+      << stats.period.percentile(0.5) / 1000 << "/"
+      << stats.period.percentile(0.99) / 1000 << "/"
+      << stats.period.max() / 1000 << "us; compute p50/p99/max "
+      << stats.compute.percentile(0.5) / 1000 << "/"
+      << stats.compute.percentile(0.99) / 1000 << "/"
+      << stats.compute.max() / 1000 << "us";
+  return out;
+}
+
+}  // namespace ackermann
@@ -0,0 +1,107 @@
+/* @file Trajectory.cpp
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <Trajectory.hpp>
+
+#include <cmath>
+
+#include <Angle.hpp>
+
+namespace ackermann {
+
+constexpr std::size_t Trajectory::kCapacity;
+
+bool Trajectory::append(const GoalSample& knot) {
+  // (wrapAngle rejects non-finite headings)
+  if (!std::isfinite(knot.speed) || std::isnan(wrapAngle(knot.heading))
+      || knot.stamp <= last_stamp_)
+    return false;
+  if (!knots_.push({knot, epoch_.load(std::memory_order_relaxed)}))
+    return false;
+  last_stamp_ = knot.stamp;
+  return true;
+}
+
+std::size_t Trajectory::append(const GoalSample* knots,
+                               const std::size_t count) {
+  std::size_t appended = 0;
+  while (appended != count && append(knots[appended]))
+    ++appended;
+  return appended;
+}
+
+void Trajectory::clear() {
+  epoch_.fetch_add(1, std::memory_order_release);
+  last_stamp_ = Clock::time_point::min();
+}
+
+std::size_t Trajectory::pending() const {
+  return knots_.size();
+}
+
+bool Trajectory::advance() {
+  Knot knot;
+  while (knots_.pop(knot)) {
+    // skip knots appended before a clear(); a later epoch starts afresh
+    if (knot.epoch < consumer_epoch_)
+      continue;
+    if (knot.epoch > consumer_epoch_) {
+      consumer_epoch_ = knot.epoch;
+      count_ = 0;
+    }
+    if (count_ == 2)
+      previous_ = next_;
+    (count_ ? next_ : previous_) = knot.goal;
+    count_ += count_ < 2;
+    return true;
+  }
+  return false;
+}
+
+bool Trajectory::sample(const Clock::time_point now,
+                        TrajectorySetpoint& setpoint) {
+  // drop the current trajectory if it has been cleared
+  const uint64_t epoch = epoch_.load(std::memory_order_acquire);
+  if (epoch != consumer_epoch_) {
+    consumer_epoch_ = epoch;
+    count_ = 0;
+  }
+
+  // take knots until the given time is bracketed (or none remain)
+  while ((count_ < 2 || next_.stamp <= now) && advance()) {}
+  if (!count_ || now < previous_.stamp)
+    return false;
+
+  setpoint = TrajectorySetpoint();
+  setpoint.goal.stamp = now;
+  if (count_ == 1 || next_.stamp <= now) {
+    // we're past the latest knot; hold it until another is appended
+    if (count_ == 2)
+      previous_ = next_;
+    count_ = 1;
+    setpoint.goal.speed = previous_.speed;
+    setpoint.goal.heading = previous_.heading;
+    return true;
+  }
+
+  // interpolate, turning along the shortest arc
+  const double span =
+    std::chrono::duration<double>(next_.stamp - previous_.stamp).count();
+  const double alpha =
+    std::chrono::duration<double>(now - previous_.stamp).count() / span;
+  const double turn = wrapAngle(next_.heading - previous_.heading);
+  setpoint.speed_rate = (next_.speed - previous_.speed) / span;
+  setpoint.heading_rate = turn / span;
+  setpoint.goal.speed = previous_.speed
+    + alpha * (next_.speed - previous_.speed);
+  setpoint.goal.heading = wrapAngle(previous_.heading + alpha * turn);
+  return true;
+}
+
+}  // namespace ackermann
@@ -0,0 +1,283 @@
+/* @file Tuner.cpp
+ * @brief Parallel Nelder-Mead search for PID gains.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ *
+ * @copyright [2020]
+ */
+
+#include <Tuner.hpp>
+#include <Angle.hpp>
+#include <Controller.hpp>
+#include <fake/plant.h>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <random>
+#include <thread>
+
+namespace ackermann {
+
+namespace {
+
+/**
+* @brief Search space: speed kp, ki, kd followed by heading kp, ki, kd.
+*/
+constexpr std::size_t kDimensions = 6;
+using Point = std::array<double, kDimensions>;
+
+/**
+* @brief Steps smaller than this are normalized as if they were this size.
+*/
+constexpr double kMinStep = 0.1;
+
+// the default scenarios: speed steps, heading steps and a combination
+std::vector<TuningScenario> defaultScenarios() {
+  return {
+    {0.0, 0.0, 5.0, 0.0, 5.0},
+    {5.0, 0.0, 1.0, 0.0, 5.0},
+    {2.0, 0.0, 2.0, -1.0, 5.0},
+    {0.0, 0.0, 3.0, M_PI/2, 5.0}};
+}
+
+Point toPoint(const ParamsSnapshot& params) {
+  return {params.pid_speed.kp, params.pid_speed.ki, params.pid_speed.kd,
+          params.pid_heading.kp, params.pid_heading.ki, params.pid_heading.kd};
+}
+
+// gains are non-negative; reflecting the search space about zero keeps
+// the Nelder-Mead simplex unconstrained
+ParamsSnapshot withGains(ParamsSnapshot params, const Point& x) {
+  params.pid_speed = {std::abs(x[0]), std::abs(x[1]), std::abs(x[2])};
+  params.pid_heading = {std::abs(x[3]), std::abs(x[4]), std::abs(x[5])};
+  return params;
+}
+
+/**
+* @brief Accumulates the step response metrics of one signal.
+*/
+class Response {
+ public:
+  Response(const double initial, const double goal, const bool angular)
+    : goal_(goal), angular_(angular) {
+    const double step = error(initial);
+    sign_ = step < 0 ? -1.0 : 1.0;
+    scale_ = std::max(std::abs(step), kMinStep);
+  }
+
+  void sample(const double value, const double time, const double dt,
+              const double band) {
+    const double normalized = error(value) / scale_;
+    error_ += std::abs(normalized) * dt;
+    overshoot_ = std::max(overshoot_, -sign_ * normalized);
+    if (std::abs(normalized) > band)
+      settling_time_ = time;
+  }
+
+  void addTo(TuningScore& score) const {
+    score.settling_time += settling_time_;
+    score.overshoot += overshoot_;
+    score.error += error_;
+  }
+
+ private:
+  double error(const double value) const {
+    return angular_ ? wrapAngle(goal_ - value) : goal_ - value;
+  }
+
+  const double goal_;
+  const bool angular_;
+  double sign_;
+  double scale_;
+  double settling_time_ {0.0};
+  double overshoot_ {0.0};
+  double error_ {0.0};
+};
+
+/**
+* @brief A vertex of the Nelder-Mead simplex.
+*/
+struct Vertex {
+  Point x;
+  double cost;
+};
+
+Point affine(const Point& origin, const Point& towards, const double t) {
+  Point p;
+  for (std::size_t i = 0; i != kDimensions; ++i)
+    p[i] = origin[i] + t * (towards[i] - origin[i]);
+  return p;
+}
+
+// minimize the cost from the given starting point
+TuningResult search(const ParamsSnapshot& params,
+                    const TuningOptions& options,
+                    const Point& start) {
+  std::size_t evaluations = 0;
+  auto vertex = [&](const Point& x) -> Vertex {
+    ++evaluations;
+    return {x, evaluate(withGains(params, x), options).cost};
+  };
+
+  // initial simplex: perturb each gain in turn
+  std::array<Vertex, kDimensions + 1> simplex;
+  simplex[0] = vertex(start);
+  for (std::size_t i = 0; i != kDimensions; ++i) {
+    Point x = start;
+    x[i] += std::max(0.5 * std::abs(x[i]), 0.1);
+    simplex[i + 1] = vertex(x);
+  }
+
+  auto by_cost = [](const Vertex& a, const Vertex& b) {
+    return a.cost < b.cost;
+  };
+  while (evaluations < options.evaluations) {
+    std::sort(simplex.begin(), simplex.end(), by_cost);
+    const Vertex& best = simplex.front();
+    Vertex& worst = simplex.back();
+    if (worst.cost - best.cost <= 1e-9 * std::abs(best.cost))
+      break;
+
+    // centroid of all but the worst vertex
+    Point centroid {};
+    for (std::size_t v = 0; v != kDimensions; ++v)
+      for (std::size_t i = 0; i != kDimensions; ++i)
+        centroid[i] += simplex[v].x[i] / kDimensions;
+
+    const Vertex reflected = vertex(affine(centroid, worst.x, -1.0));
+    if (reflected.cost < best.cost) {
+      const Vertex expanded = vertex(affine(centroid, worst.x, -2.0));
+      worst = expanded.cost < reflected.cost ? expanded : reflected;
+    } else if (reflected.cost < simplex[kDimensions - 1].cost) {
+      worst = reflected;
+    } else {
+      // contract towards the better of the reflected and worst vertices
+      const bool outside = reflected.cost < worst.cost;
+      const Vertex contracted = vertex(
+        affine(centroid, outside ? reflected.x : worst.x, 0.5));
+      if (contracted.cost < std::min(reflected.cost, worst.cost)) {
+        worst = contracted;
+      } else {
+        // shrink towards the best vertex
+        for (std::size_t v = 1; v != simplex.size(); ++v)
+          simplex[v] = vertex(affine(simplex[0].x, simplex[v].x, 0.5));
+      }
+    }
+  }
+
+  const Vertex& best = *std::min_element(simplex.begin(), simplex.end(),
+                                         by_cost);
+  const ParamsSnapshot gains = withGains(params, best.x);
+  TuningResult result;
+  result.pid_speed = gains.pid_speed;
+  result.pid_heading = gains.pid_heading;
+  result.score = evaluate(gains, options);
+  result.evaluations = evaluations;
+  return result;
+}
+
+}  // namespace
+
+TuningScore evaluate(const ParamsSnapshot& params,
+                     const TuningOptions& options) {
+  const std::vector<TuningScenario> defaults =
+    options.scenarios.empty() ? defaultScenarios()
+                              : std::vector<TuningScenario>();
+  const std::vector<TuningScenario>& scenarios =
+    options.scenarios.empty() ? defaults : options.scenarios;
+
+  auto shared = std::make_shared<Params>(params.wheel_base,
+                                         params.track_width,
+                                         params.max_steering_angle,
+                                         0.0, 0.0);
+  shared->restore(params);
+  Controller controller(shared);
+  fake::Plant plant(fake::PlantOptions(params.wheel_base,
+                                       params.max_steering_angle),
+                    shared);
+
+  TuningScore score;
+  const double dt = options.dt;
+  for (const TuningScenario& scenario : scenarios) {
+    controller.reset();
+    plant.setState(scenario.initial_speed, scenario.initial_heading);
+    controller.setGoal(scenario.goal_speed, scenario.goal_heading);
+    Response speed(scenario.initial_speed, scenario.goal_speed, false);
+    Response heading(scenario.initial_heading, scenario.goal_heading, true);
+
+    // closed loop simulation (see Controller::step())
+    const std::size_t steps = std::lround(scenario.duration / dt);
+    for (std::size_t i = 0; i != steps; ++i) {
+      double current_speed, current_heading;
+      plant.getState(current_speed, current_heading);
+      controller.setState(current_speed, current_heading);
+      controller.step(dt);
+
+      double throttle, steering;
+      controller.getCommand(throttle, steering);
+      plant.command(throttle, steering, dt);
+
+      plant.getState(current_speed, current_heading);
+      const double time = (i + 1) * dt;
+      speed.sample(current_speed, time, dt, options.settling_band);
+      heading.sample(current_heading, time, dt, options.settling_band);
+    }
+    speed.addTo(score);
+    heading.addTo(score);
+  }
+
+  score.cost = options.settling_weight * score.settling_time
+    + options.overshoot_weight * score.overshoot
+    + options.error_weight * score.error;
+  if (!std::isfinite(score.cost))
+    score.cost = std::numeric_limits<double>::infinity();
+  return score;
+}
+
+TuningResult tune(const ParamsSnapshot& params, const TuningOptions& options) {
+  // pick every starting point up front, so results don't depend on the
+  // order in which the searches execute
+  const std::size_t starts = std::max<std::size_t>(options.starts, 1);
+  std::vector<Point> points(starts, toPoint(params));
+  std::mt19937_64 generator(options.seed);
+  std::normal_distribution<double> scale(0.0, 1.0);
+  for (std::size_t s = 1; s != starts; ++s)
+    for (double& gain : points[s])
+      gain = (std::abs(gain) + 0.1) * std::exp(scale(generator));
+
+  // execute the searches in parallel
+  std::vector<TuningResult> results(starts);
+  std::atomic<std::size_t> next {0};
+  auto worker = [&]() {
+    for (std::size_t s = next++; s < starts; s = next++)
+      results[s] = search(params, options, points[s]);
+  };
+  unsigned int threads = options.threads ? options.threads
+                                         : std::thread::hardware_concurrency();
+  threads = std::max(1u, std::min<unsigned int>(threads, starts));
+  std::vector<std::thread> pool;
+  for (unsigned int t = 1; t < threads; ++t)
+    pool.emplace_back(worker);
+  worker();
+  for (std::thread& thread : pool)
+    thread.join();
+
+  // report the best result (the earliest search wins ties)
+  TuningResult best = results.front();
+  std::size_t evaluations = 0;
+  for (const TuningResult& result : results) {
+    evaluations += result.evaluations;
+    if (result.score.cost < best.score.cost)
+      best = result;
+  }
+  best.evaluations = evaluations;
+  return best;
+}
+
+}  // namespace ackermann
@@ -16,7 +16,8 @@ int main(int argc, char *argv[]) {
     0.45, 0.45, 0.785, 0.02, 0.2);
 
   // construct controller class
-  auto controller = std::make_shared<ackermann::Controller>(params);
+  auto controller = std::make_shared<ackermann::Controller>(
+    params, ackermann::kDefaultTelemetryCapacity);
 
   // Construct dummy plant class
   fake::PlantOptions opts(0.45, 0.785);
@@ -7,6 +7,10 @@
 
 #include <math.h>
 
+#include <cmath>
+#include <iostream>
+#include <vector>
+
 #include <QCheckBox>
 #include <QGridLayout>
 #include <QGroupBox>
@@ -31,6 +35,13 @@ Window::Window(QWidget *parent)
 }
 
 void Window::init() {
+  // the plotted history: TIMEWINDOW worth of samples per series
+  const std::size_t samples = std::lround(TIMEWINDOW / TIMESTEP);
+  history_.reserve(PlotCount);
+  for (std::size_t i = 0; i != PlotCount; ++i)
+    history_.emplace_back(samples, PLOTPOINTS);
+  points_.reserve(PLOTPOINTS + 2);
+
   QGridLayout *grid = new QGridLayout;
   grid->addWidget(createParametersGroup(), 0, 0);
   grid->addWidget(createSetpointsGroup(), 1, 0);
@@ -42,6 +53,11 @@ void Window::init() {
 
   setWindowTitle(tr("Group Boxes"));
   resize(1560, 1280);
+
+  // render at display rate on the GUI thread
+  renderTimer = new QTimer(this);
+  connect(renderTimer, SIGNAL(timeout()), this, SLOT(render()));
+  renderTimer->start(static_cast<int>(1000 / DISPLAYRATE));
 }
 
 void Window::start() {
@@ -79,7 +95,12 @@ void Window::reset() {
     controller_->setGoal(speed_setpoint_, heading_setpoint_);
     plant_->setState(initial_speed_, initial_heading_);
 
-    // also reset our line series and clear our chart view
+    // also reset our plot history, line series and chart view
+    PlotSample sample;
+    while (samples_.pop(sample)) {}
+    for (auto& history : history_)
+      history.clear();
+    latest_time_ = 0.0;
     speedSetpointSeries->clear();
     speedAchievedSeries->clear();
     speedGoalSeries->clear();
@@ -103,16 +124,15 @@ void Window::execute() {
   // initialize time and some handy variables
   double time = 0.0;
 
-  // initialize range values
-  double speed_min = 0.0;
-  double speed_max = 1.0;
-  double heading_min = -M_PI/4.0;
-  double heading_max = M_PI/4.0;
-  double command_min = 0.0;
-  double command_max = 1.0;
+  // controller telemetry buffer
+  std::vector<ackermann::TelemetryRecord> records(
+    controller_->getTelemetryCapacity());
+  ackermann::TelemetryRecord latest;
 
-  // start controller
+  // start controller, reporting any loop timing problems off its thread
   controller_->start();
+  ackermann::TimingLogger timing_logger(
+    [this](){return controller_->getTimingStats();}, std::cerr);
 
   // continually evaluate the controller's commands and send them to the plant
   while (!stop_) {
@@ -123,72 +143,32 @@ void Window::execute() {
     double current_speed, current_heading;
     plant_->getState(current_speed, current_heading);
 
-    // poll controller for current goal
-    double target_speed, target_heading;
-    controller_->getGoal(target_speed, target_heading);
-
-    // get the latest controller command
-    double throttle, steering;
-    controller_->getCommand(throttle, steering);
-
-    // get the latest wheel speeds
-    double left_front, right_front, left_rear, right_rear;
-    controller_->getWheelLinVel(left_front, right_front, left_rear, right_rear);
+    // retrieve everything the controller computed since our last poll, and
+    // display its latest (self consistent) iteration
+    std::size_t count = controller_->drainTelemetry(records.data(),
+                                                    records.size());
+    if (count)
+      latest = records[count - 1];
 
     // apply the command to the plant
-    plant_->command(throttle, steering, TIMESTEP);
-
-    // update the QT series with our latest information
-    speedSetpointSeries->append(time, speed_setpoint_);
-    speedGoalSeries->append(time, target_speed);
-    speedAchievedSeries->append(time, current_speed);
-    speedLeftFrontWheelSeries->append(time, left_front);
-    speedRightFrontWheelSeries->append(time, right_front);
-    speedLeftRearWheelSeries->append(time, left_rear);
-    speedRightRearWheelSeries->append(time, right_rear);
-    headingSetpointSeries->append(time, heading_setpoint_);
-    headingGoalSeries->append(time, target_heading);
-    headingAchievedSeries->append(time, current_heading);
-    commandThrottleSeries->append(time, throttle);
-    commandSteeringSeries->append(time, steering);
-
-    // update the QT charts
-    double x_min = std::max(0.0, time - TIMEWINDOW);
-    speedChart->axisX()->setRange(x_min, time);
-    headingChart->axisX()->setRange(x_min, time);
-    commandChart->axisX()->setRange(x_min, time);
-
-    // update the Y ranges
-    speed_min = std::min({speed_min,
-                          static_cast<double>(speed_setpoint_),
-                          target_speed,
-                          current_speed,
-                          left_front,
-                          right_front,
-                          left_rear,
-                          right_rear});
-    speed_max = std::max({speed_max,
-                          static_cast<double>(speed_setpoint_),
-                          target_speed,
-                          current_speed,
-                          left_front,
-                          right_front,
-                          left_rear,
-                          right_rear});
-    heading_min = std::min({heading_min,
-                            static_cast<double>(heading_setpoint_),
-                            target_heading,
-                            current_heading});
-    heading_max = std::max({heading_max,
-                            static_cast<double>(heading_setpoint_),
-                            target_heading,
-                            current_heading});
-    command_min = std::min({command_min, throttle, steering});
-    command_max = std::max({command_max, throttle, steering});
-
-    speedChart->axisY()->setRange(speed_min, speed_max);
-    headingChart->axisY()->setRange(heading_min, heading_max);
-    commandChart->axisY()->setRange(command_min, command_max);
+    plant_->command(latest.throttle, latest.steering, TIMESTEP);
+
+    // hand our latest information to the GUI thread
+    PlotSample sample;
+    sample.time = time;
+    sample.values[SpeedSetpoint] = speed_setpoint_;
+    sample.values[SpeedGoal] = latest.goal.speed;
+    sample.values[SpeedAchieved] = current_speed;
+    sample.values[SpeedLeftFrontWheel] = latest.wheel_left_front;
+    sample.values[SpeedRightFrontWheel] = latest.wheel_right_front;
+    sample.values[SpeedLeftRearWheel] = latest.wheel_left_rear;
+    sample.values[SpeedRightRearWheel] = latest.wheel_right_rear;
+    sample.values[HeadingSetpoint] = heading_setpoint_;
+    sample.values[HeadingGoal] = latest.goal.heading;
+    sample.values[HeadingAchieved] = current_heading;
+    sample.values[CommandThrottle] = latest.throttle;
+    sample.values[CommandSteering] = latest.steering;
+    samples_.push(sample);
 
     // sleep and update our timestamp
     std::this_thread::sleep_for(std::chrono::milliseconds(
@@ -200,6 +180,59 @@ void Window::execute() {
   controller_->stop();
 }
 
+void Window::render() {
+  // move any new samples into our (bounded) history
+  PlotSample sample;
+  bool updated = false;
+  while (samples_.pop(sample)) {
+    for (std::size_t i = 0; i != PlotCount; ++i)
+      history_[i].append(sample.time, sample.values[i]);
+    latest_time_ = sample.time;
+    updated = true;
+  }
+  if (!updated)
+    return;
+
+  // replace each series' points in bulk (a single redraw per series)
+  const std::array<QLineSeries*, PlotCount> series {
+    speedSetpointSeries, speedGoalSeries, speedAchievedSeries,
+    speedLeftFrontWheelSeries, speedRightFrontWheelSeries,
+    speedLeftRearWheelSeries, speedRightRearWheelSeries,
+    headingSetpointSeries, headingGoalSeries, headingAchievedSeries,
+    commandThrottleSeries, commandSteeringSeries};
+  for (std::size_t i = 0; i != PlotCount; ++i) {
+    points_.clear();
+    history_[i].forEach([this](const double time, const double value) {
+      points_.append(QPointF(time, value));
+    });
+    series[i]->replace(points_);
+  }
+
+  // update the X ranges
+  double x_min = std::max(0.0, latest_time_ - TIMEWINDOW);
+  speedChart->axisX()->setRange(x_min, latest_time_);
+  headingChart->axisX()->setRange(x_min, latest_time_);
+  commandChart->axisX()->setRange(x_min, latest_time_);
+
+  // update the Y ranges (to fit everything displayed)
+  double speed_min = 0.0;
+  double speed_max = 1.0;
+  for (std::size_t i = SpeedSetpoint; i <= SpeedRightRearWheel; ++i)
+    history_[i].range(speed_min, speed_max);
+  double heading_min = -M_PI/4.0;
+  double heading_max = M_PI/4.0;
+  for (std::size_t i = HeadingSetpoint; i <= HeadingAchieved; ++i)
+    history_[i].range(heading_min, heading_max);
+  double command_min = 0.0;
+  double command_max = 1.0;
+  for (std::size_t i = CommandThrottle; i <= CommandSteering; ++i)
+    history_[i].range(command_min, command_max);
+
+  speedChart->axisY()->setRange(speed_min, speed_max);
+  headingChart->axisY()->setRange(heading_min, heading_max);
+  commandChart->axisY()->setRange(command_min, command_max);
+}
+
 QGroupBox *Window::createParametersGroup() {
   // Construct group box containing all settable parameters
 
@@ -218,7 +251,10 @@ QGroupBox *Window::createParametersGroup() {
   connect(controlFrequency,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->control_frequency = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.control_frequency = new_val;});
+          });
 
   // wheel base
   QLabel *wheelBaseLabel = new QLabel(tr("Vehicle wheel base:"));
@@ -230,7 +266,10 @@ QGroupBox *Window::createParametersGroup() {
   connect(wheelBase,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->wheel_base = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.wheel_base = new_val;});
+          });
 
   // track width
   QLabel *trackWidthLabel = new QLabel(tr("Vehicle track width:"));
@@ -242,7 +281,10 @@ QGroupBox *Window::createParametersGroup() {
   connect(trackWidth,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->track_width = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.track_width = new_val;});
+          });
 
   // max steering angle
   QLabel *maxSteeringAngleLabel = new QLabel(
@@ -257,7 +299,10 @@ QGroupBox *Window::createParametersGroup() {
   connect(maxSteeringAngle,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->max_steering_angle = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.max_steering_angle = new_val;});
+          });
 
   // heading PID params (KP, KI, KD)
   QLabel *headingPIDLabel = new QLabel(tr("Heading PID Parameters:"));
@@ -277,15 +322,24 @@ QGroupBox *Window::createParametersGroup() {
   connect(kpHeading,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->pid_heading->kp = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.pid_heading->kp = new_val;});
+          });
   connect(kiHeading,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->pid_heading->ki = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.pid_heading->ki = new_val;});
+          });
   connect(kdHeading,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->pid_heading->kd = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.pid_heading->kd = new_val;});
+          });
 
   // speed PID params (KP, KI, KD)
   QLabel *speedPIDLabel = new QLabel(tr("Speed PID Parameters:"));
@@ -305,15 +359,24 @@ QGroupBox *Window::createParametersGroup() {
   connect(kpSpeed,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->pid_speed->kp = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.pid_speed->kp = new_val;});
+          });
   connect(kiSpeed,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->pid_speed->ki = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.pid_speed->ki = new_val;});
+          });
   connect(kdSpeed,
           QOverload<double>::of(&QDoubleSpinBox::valueChanged),
           this,
-          [this](double new_val){params_->pid_speed->kd = new_val;});
+          [this](double new_val){
+            params_->update([new_val](ackermann::Params& p){
+              p.pid_speed->kd = new_val;});
+          });
 
   // add all parameters to box
   QVBoxLayout *vbox = new QVBoxLayout;
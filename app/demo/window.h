@@ -14,6 +14,7 @@
  */
 
 #include <QWidget>
+#include <QTimer>
 #include <QtCharts>
 #include <fake/plant.h>
 
@@ -22,13 +23,19 @@
 #include <thread>
 #include <chrono>
 #include <algorithm>
+#include <array>
+#include <vector>
 
 #include <Params.hpp>
 #include <Controller.hpp>
+#include <PlotBuffer.hpp>
+#include <SpscRing.hpp>
 
 // some handy visualization variables
 #define TIMESTEP 0.1
 #define TIMEWINDOW 10.0
+#define DISPLAYRATE 30.0
+#define PLOTPOINTS 1000
 
 QT_BEGIN_NAMESPACE
 class QGroupBox;
@@ -69,7 +76,40 @@ class Window : public QWidget {
   */
   void reset();
 
+ private slots:
+  /**
+  * @brief Update the charts with any new samples (on the GUI thread).
+  */
+  void render();
+
  private:
+  /**
+  * @brief Plotted signals (one line series each).
+  */
+  enum Plot {
+    SpeedSetpoint,
+    SpeedGoal,
+    SpeedAchieved,
+    SpeedLeftFrontWheel,
+    SpeedRightFrontWheel,
+    SpeedLeftRearWheel,
+    SpeedRightRearWheel,
+    HeadingSetpoint,
+    HeadingGoal,
+    HeadingAchieved,
+    CommandThrottle,
+    CommandSteering,
+    PlotCount
+  };
+
+  /**
+  * @brief The value of every plotted signal at a single time.
+  */
+  struct PlotSample {
+    double time;
+    std::array<double, PlotCount> values;
+  };
+
   /**
   * @brief Initialize QT GUI class.
   * 
@@ -79,7 +119,9 @@ class Window : public QWidget {
 
   /**
   * @brief Execution loop; spun off as an asynchronous thread.
-  */
+   *
+   * This never touches Qt objects; samples are handed to render().
+   */
   void execute();
 
   // Group boxes, for logical grouping of GUI sections.
@@ -115,6 +157,18 @@ class Window : public QWidget {
   QChart* headingChart;
   QChart* commandChart;
 
+  // periodically calls render()
+  QTimer* renderTimer;
+
+  // samples produced by execute(), waiting to be rendered
+  ackermann::SpscRing<PlotSample, 1024> samples_;
+
+  // bounded history of each series (only accessed by the GUI thread), and
+  // a buffer reused to replace the points of a series
+  std::vector<ackermann::PlotBuffer> history_;
+  QVector<QPointF> points_;
+  double latest_time_ {0.0};
+
   // setpoint (e.g. goal) data set through UI
   std::atomic<double> speed_setpoint_ {0.0};
   std::atomic<double> heading_setpoint_ {0.0};
@@ -0,0 +1,76 @@
+/* @file noise.cpp
+ * @copyright [2020]
+ */
+
+#include <fake/noise.h>
+
+#include <cmath>
+
+namespace fake {
+
+namespace {
+
+// the SplitMix64 increment and finalizer
+constexpr uint64_t kGamma = 0x9e3779b97f4a7c15ULL;
+
+// 2^-53
+constexpr double kUniformScale = 1.0 / 9007199254740992.0;
+
+uint64_t mix(uint64_t z) {
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+  return z ^ (z >> 31);
+}
+
+}  // namespace
+
+Random::Random(const uint64_t seed, const uint64_t stream)
+  : counter_(mix(mix(seed) + stream * kGamma)) {
+}
+
+uint64_t Random::next() {
+  return mix(counter_ += kGamma);
+}
+
+double Random::uniform() {
+  // the top 53 bits, scaled to [0, 1)
+  return (next() >> 11) * kUniformScale;
+}
+
+NoiseSource::NoiseSource(const uint64_t seed, const uint64_t stream)
+  : random_(seed, stream) {
+}
+
+void NoiseSource::refill() {
+  static_assert(kBatch % 2 == 0, "samples are generated in pairs");
+  // Marsaglia's polar method (Box-Muller without the trigonometry)
+  for (std::size_t i = 0; i != kBatch; i += 2) {
+    double u, v, s;
+    do {
+      u = 2 * random_.uniform() - 1;
+      v = 2 * random_.uniform() - 1;
+      s = u * u + v * v;
+    } while (s >= 1 || s == 0);
+    const double scale = std::sqrt(-2 * std::log(s) / s);
+    buffer_[i] = u * scale;
+    buffer_[i + 1] = v * scale;
+  }
+  index_ = 0;
+}
+
+double RandomWalk::apply(const double value, const double dt,
+                         NoiseSource& source) {
+  offset_ += stddev_ * std::sqrt(dt) * source.gaussian();
+  return value + offset_;
+}
+
+double Dropout::apply(const double value, const double,
+                      NoiseSource& source) {
+  if (!valid_ || source.uniform() >= probability_) {
+    last_ = value;
+    valid_ = true;
+  }
+  return last_;
+}
+
+}  // namespace fake
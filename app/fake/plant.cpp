@@ -3,15 +3,63 @@
  */
 
 #include <fake/plant.h>
+#include <Angle.hpp>
+#include <algorithm>
 #include <iostream>
+#include <utility>
 
 namespace fake {
 
+namespace {
+
+/**
+* @brief The integrated plant state.
+*/
+struct State {
+  double speed, steering, heading;
+};
+
+/**
+* @brief Time derivative of the plant state under constant commands.
+*/
+struct Dynamics {
+  double target_speed, target_steering;
+  double throttle_rate, steering_rate;   // inverse time constants
+  double wheel_base;
+
+  State operator()(const State& s) const {
+    return {(target_speed - s.speed) * throttle_rate,
+            (target_steering - s.steering) * steering_rate,
+            (s.speed / wheel_base) * std::tan(s.steering)};
+  }
+};
+
+State advance(const State& s, const State& d, const double h) {
+  return {s.speed + h * d.speed,
+          s.steering + h * d.steering,
+          s.heading + h * d.heading};
+}
+
+// a single classic Runge-Kutta step
+State rk4(const Dynamics& f, const State& s, const double h) {
+  const State k1 = f(s);
+  const State k2 = f(advance(s, k1, h/2));
+  const State k3 = f(advance(s, k2, h/2));
+  const State k4 = f(advance(s, k3, h));
+  return {s.speed + h/6 * (k1.speed + 2*k2.speed + 2*k3.speed + k4.speed),
+          s.steering + h/6 * (k1.steering + 2*k2.steering + 2*k3.steering
+                              + k4.steering),
+          s.heading + h/6 * (k1.heading + 2*k2.heading + 2*k3.heading
+                             + k4.heading)};
+}
+
+}  // namespace
+
 Plant::Plant(const PlantOptions& opts,
              const std::shared_ptr<const ackermann::Params>& params)
   : opts_(opts),
     params_(params),
-    dist_(opts.noise_mean, opts.noise_stddev),
+    noise_(opts.noise_seed, opts.noise_stream),
     limits_(std::make_unique<ackermann::Limits>(params)) {
   this->reset();
 }
@@ -19,11 +67,20 @@ Plant::Plant(const PlantOptions& opts,
 void Plant::reset() {
   speed_ = 0.0;
   heading_ = 0.0;
+  steering_ = 0.0;
+  measured_speed_ = 0.0;
+  measured_heading_ = 0.0;
+  noise_ = NoiseSource(opts_.noise_seed, opts_.noise_stream);
+  for (auto* models : {&speed_noise_, &heading_noise_})
+    for (auto& model : *models)
+      model->reset();
 }
 
 void Plant::setState(const double speed, const double heading) {
   speed_ = speed;
-  heading_ = limits_->boundHeading(heading);
+  heading_ = ackermann::wrapAngle(heading);
+  measured_speed_ = speed_;
+  measured_heading_ = heading_;
 }
 
 void Plant::getState(double& speed, double& heading) const {
@@ -31,6 +88,21 @@ void Plant::getState(double& speed, double& heading) const {
   heading = heading_;
 }
 
+void Plant::addSensorNoise(const Signal signal,
+                           std::unique_ptr<NoiseModel> model) {
+  auto& models = signal == Signal::Speed ? speed_noise_ : heading_noise_;
+  models.push_back(std::move(model));
+}
+
+void Plant::getMeasurement(double& speed, double& heading) const {
+  speed = measured_speed_;
+  heading = measured_heading_;
+}
+
+void Plant::getSteering(double& steering) const {
+  steering = steering_;
+}
+
 void Plant::command(const double throttle,
                     const double steering,
                     const double dt) {
@@ -41,19 +113,52 @@ void Plant::command(const double throttle,
                       opts_.max_steering_angle;
   }
 
-  // throttle translates directly to speed, since we have no other system
-  // knowledge
-  speed_ = limits_->throttleToSpeed(throttle);
+  // throttle translates to speed, since we have no other system knowledge
+  const double target_speed = limits_->throttleToSpeed(throttle);
+  const double wheel_base = params_->wheel_base;
+
+  if (opts_.throttle_time_constant <= 0 && opts_.steering_time_constant <= 0) {
+    // no actuator dynamics; the heading rate is constant over the timestep
+    speed_ = target_speed;
+    steering_ = steering_capped;
+    this->heading_ = ackermann::wrapAngle(this->heading_
+                     + ((this->speed_/wheel_base)
+                        * tan(steering_capped) * dt));
+  } else {
+    // actuators without a lag respond instantly
+    Dynamics f {target_speed, steering_capped, 0.0, 0.0, wheel_base};
+    State s {speed_, steering_, heading_};
+    if (opts_.throttle_time_constant > 0)
+      f.throttle_rate = 1 / opts_.throttle_time_constant;
+    else
+      s.speed = target_speed;
+    if (opts_.steering_time_constant > 0)
+      f.steering_rate = 1 / opts_.steering_time_constant;
+    else
+      s.steering = steering_capped;
 
-  // the global heading is affected by our speed, steering angle, and wheel base
-  // heading_ += dt * (speed_ / opts_.wheel_base) * std::tan(steering_capped);
-  this->heading_ = limits_->boundHeading(this->heading_
-                   + ((this->speed_/params_->wheel_base)
-                      * tan(steering_capped) * dt));
+    // the global heading is affected by our speed, steering angle, and
+    // wheel base
+    const unsigned int substeps = std::max(opts_.substeps, 1u);
+    const double h = dt / substeps;
+    for (unsigned int i = 0; i != substeps; ++i)
+      s = rk4(f, s, h);
+    speed_ = s.speed;
+    steering_ = s.steering;
+    heading_ = ackermann::wrapAngle(s.heading);
+  }
 
   // add in some noise for good measure
-  speed_ += dist_(generator_);
-  heading_ += dist_(generator_);
+  speed_ += opts_.noise_mean + opts_.noise_stddev * noise_.gaussian();
+  heading_ += opts_.noise_mean + opts_.noise_stddev * noise_.gaussian();
+
+  // and measure the result
+  measured_speed_ = speed_;
+  for (auto& model : speed_noise_)
+    measured_speed_ = model->apply(measured_speed_, dt, noise_);
+  measured_heading_ = heading_;
+  for (auto& model : heading_noise_)
+    measured_heading_ = model->apply(measured_heading_, dt, noise_);
 }
 
 }  // namespace fake
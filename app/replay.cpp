@@ -0,0 +1,47 @@
+/* @file replay.cpp
+ * @brief Replay a flight recording and report any divergence.
+ *
+ * Usage: replay <recording> [tolerance]
+ *
+ * @copyright [2020]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+
+#include <Replay.hpp>
+
+int main(int argc, char *argv[]) {
+  if (argc < 2) {
+    std::cerr << "Usage: " << argv[0] << " <recording> [tolerance]"
+              << std::endl;
+    return 2;
+  }
+  const double tolerance = argc > 2 ? std::atof(argv[2]) : 0.0;
+
+  try {
+    ackermann::FlightLog log(argv[1]);
+    const auto start = std::chrono::steady_clock::now();
+    const ackermann::ReplayResult result = ackermann::replay(log, tolerance);
+    const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+
+    std::cout << "Replayed " << result.ticks << " ticks ("
+              << result.inputs << " recorded inputs) in "
+              << elapsed.count() << "s" << std::endl;
+    if (result.divergent_ticks) {
+      std::cout << result.divergent_ticks << " ticks diverged, first at tick "
+                << result.first_divergence << "; max error "
+                << result.max_error << std::endl;
+      return 1;
+    }
+    std::cout << "No divergence (max error " << result.max_error << ")"
+              << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+  return 0;
+}
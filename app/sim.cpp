@@ -0,0 +1,131 @@
+/* @file sim.cpp
+ * @brief Run a closed loop scenario headless, streaming every tick.
+ *
+ * Usage: sim <scenario> [-f csv|binary] [-o output] [-x speedup]
+ *
+ * Results are written to stdout unless an output file is given. The binary
+ * format is the 8 byte magic "ACKSIM01", the uint32 record size, and then
+ * one native SimulationSample per tick.
+ *
+ * @copyright [2020]
+ */
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <Simulation.hpp>
+
+namespace {
+
+int usage(const char* name) {
+  std::cerr << "Usage: " << name
+            << " <scenario> [-f csv|binary] [-o output] [-x speedup]"
+            << std::endl;
+  return 2;
+}
+
+void writeCsvHeader(std::ostream& out) {
+  out << "tick,time,goal_speed,goal_heading,speed,heading,"
+         "measured_speed,measured_heading,throttle,steering\n";
+}
+
+void writeCsv(std::ostream& out, const ackermann::SimulationSample& s) {
+  char line[512];
+  const int length = std::snprintf(
+    line, sizeof(line), "%llu,%.6f,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g,%.9g\n",
+    static_cast<unsigned long long>(s.tick), s.time,  // NOLINT(runtime/int)
+    s.goal_speed, s.goal_heading, s.speed, s.heading,
+    s.measured_speed, s.measured_heading, s.throttle, s.steering);
+  out.write(line, length);
+}
+
+void writeBinaryHeader(std::ostream& out) {
+  const uint32_t size = sizeof(ackermann::SimulationSample);
+  out.write("ACKSIM01", 8);
+  out.write(reinterpret_cast<const char*>(&size), sizeof(size));
+}
+
+void writeBinary(std::ostream& out, const ackermann::SimulationSample& s) {
+  out.write(reinterpret_cast<const char*>(&s), sizeof(s));
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  if (argc < 2)
+    return usage(argv[0]);
+
+  std::string format = "csv";
+  std::string output;
+  double speedup = 0.0;
+  for (int i = 2; i < argc; ++i) {
+    if (i + 1 == argc)
+      return usage(argv[0]);
+    if (!std::strcmp(argv[i], "-f"))
+      format = argv[++i];
+    else if (!std::strcmp(argv[i], "-o"))
+      output = argv[++i];
+    else if (!std::strcmp(argv[i], "-x"))
+      speedup = std::atof(argv[++i]);
+    else
+      return usage(argv[0]);
+  }
+  if (format != "csv" && format != "binary")
+    return usage(argv[0]);
+
+  try {
+    std::ifstream file(argv[1]);
+    if (!file) {
+      std::cerr << "Unable to open " << argv[1] << std::endl;
+      return 2;
+    }
+    const ackermann::Scenario scenario = ackermann::parseScenario(file);
+
+    std::ofstream out_file;
+    if (!output.empty()) {
+      out_file.open(output, std::ios::binary);
+      if (!out_file) {
+        std::cerr << "Unable to open " << output << std::endl;
+        return 2;
+      }
+    }
+    std::ostream& out = output.empty() ? std::cout : out_file;
+    std::ios::sync_with_stdio(false);
+
+    const bool csv = format == "csv";
+    if (csv)
+      writeCsvHeader(out);
+    else
+      writeBinaryHeader(out);
+
+    const auto start = std::chrono::steady_clock::now();
+    uint64_t ticks = 0;
+    ackermann::simulate(scenario,
+                        [&](const ackermann::SimulationSample& sample) {
+                          if (csv)
+                            writeCsv(out, sample);
+                          else
+                            writeBinary(out, sample);
+                          ++ticks;
+                        },
+                        speedup);
+    out.flush();
+    const std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+    std::cerr << "Simulated " << ticks << " ticks (" << scenario.duration
+              << "s) in " << elapsed.count() << "s" << std::endl;
+    if (!out)
+      return 1;
+  } catch (const std::exception& e) {
+    std::cerr << e.what() << std::endl;
+    return 2;
+  }
+  return 0;
+}
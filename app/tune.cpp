@@ -0,0 +1,62 @@
+/* @file tune.cpp
+ * @brief Search for PID gains of the demo vehicle in simulation.
+ *
+ * Usage: tune [starts] [evaluations per start] [threads]
+ *
+ * @copyright [2020]
+ */
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+
+#include <Params.hpp>
+#include <Tuner.hpp>
+
+namespace {
+
+void print(const char* name, const ackermann::PIDGains& gains) {
+  std::cout << "  " << name << ": kp " << gains.kp << ", ki " << gains.ki
+            << ", kd " << gains.kd << std::endl;
+}
+
+void print(const ackermann::TuningScore& score) {
+  std::cout << "  cost " << score.cost << " (settling " << score.settling_time
+            << "s, overshoot " << score.overshoot << ", error "
+            << score.error << ")" << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  ackermann::TuningOptions options;
+  if (argc > 1)
+    options.starts = std::strtoul(argv[1], nullptr, 10);
+  if (argc > 2)
+    options.evaluations = std::strtoul(argv[2], nullptr, 10);
+  if (argc > 3)
+    options.threads = std::strtoul(argv[3], nullptr, 10);
+
+  // the demo vehicle (see demo.cpp)
+  auto params = std::make_shared<ackermann::Params>(
+    0.45, 0.45, 0.785, 0.02, 0.2);
+  const ackermann::ParamsSnapshot initial = params->snapshot();
+
+  std::cout << "Initial gains:" << std::endl;
+  print("speed", initial.pid_speed);
+  print("heading", initial.pid_heading);
+  print(ackermann::evaluate(initial, options));
+
+  const auto start = std::chrono::steady_clock::now();
+  const ackermann::TuningResult result = ackermann::tune(initial, options);
+  const std::chrono::duration<double> elapsed =
+    std::chrono::steady_clock::now() - start;
+
+  std::cout << "Best gains (" << result.evaluations << " candidates in "
+            << elapsed.count() << "s):" << std::endl;
+  print("speed", result.pid_speed);
+  print("heading", result.pid_heading);
+  print(result.score);
+  return 0;
+}
@@ -0,0 +1,25 @@
+/* @file Angle.cpp
+ * @brief Microbenchmarks of angle wrapping.
+ *
+ * @copyright [2020]
+ */
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <vector>
+
+#include <Angle.hpp>
+
+/* @brief Wrap an array of angles; the argument is the array size. */
+static void BM_Angle_WrapAngles(benchmark::State& state) {
+  std::vector<double> angles(state.range(0));
+  for (std::size_t i = 0; i != angles.size(); ++i)
+    angles[i] = (i % 97) * 0.77 * M_PI;
+  std::vector<double> wrapped(angles.size());
+  for (auto _ : state) {
+    ackermann::wrapAngles(angles.data(), wrapped.data(), angles.size());
+    benchmark::ClobberMemory();
+  }
+  state.SetItemsProcessed(state.iterations() * angles.size());
+}
+BENCHMARK(BM_Angle_WrapAngles)->Arg(64)->Arg(4096);
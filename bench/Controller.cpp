@@ -0,0 +1,35 @@
+/* @file Controller.cpp
+ * @brief Benchmark of a full controller iteration.
+ *
+ * @copyright [2020]
+ */
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include <Controller.hpp>
+#include <Params.hpp>
+
+using ackermann::Controller;
+using ackermann::Params;
+
+/* @brief A complete tick: state update, control iteration and telemetry. */
+static void BM_Controller_Tick(benchmark::State& state) {
+  auto params = std::make_shared<Params>(0.45, 0.5, 0.785, 1.0, 1.0);
+  params->pid_speed->ki = 0.5;
+  params->pid_heading->ki = 0.5;
+  Controller controller(params, ackermann::kDefaultTelemetryCapacity);
+  controller.setGoal(3.0, 1.2);
+
+  ackermann::TelemetryRecord record;
+  double speed = 0.0, heading = 0.0;
+  for (auto _ : state) {
+    // feed the previous estimate back in as a measurement
+    controller.setState(speed, heading);
+    controller.step(0.01);
+    controller.getState(speed, heading);
+    controller.drainTelemetry(&record, 1);
+  }
+  benchmark::DoNotOptimize(record);
+}
+BENCHMARK(BM_Controller_Tick);
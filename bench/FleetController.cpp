@@ -0,0 +1,62 @@
+/* @file FleetController.cpp
+ * @brief Benchmark of stepping a fleet of vehicles, in a single
+ * FleetController and as individual Controllers.
+ *
+ * @copyright [2020]
+ */
+#include <benchmark/benchmark.h>
+
+#include <memory>
+#include <vector>
+
+#include <Controller.hpp>
+#include <FleetController.hpp>
+#include <Params.hpp>
+
+using ackermann::Controller;
+using ackermann::FleetController;
+using ackermann::Params;
+
+namespace {
+
+std::shared_ptr<Params> fleetParams() {
+  auto params = std::make_shared<Params>(0.45, 0.5, 0.785, 1.0, 1.0);
+  params->pid_speed->ki = 0.5;
+  params->pid_heading->ki = 0.5;
+  return params;
+}
+
+}  // namespace
+
+/* @brief Step a fleet (of range(0) vehicles) at once. */
+static void BM_Fleet_Step(benchmark::State& state) {
+  const std::size_t size = state.range(0);
+  FleetController fleet(fleetParams(), size);
+  for (std::size_t i = 0; i != size; ++i)
+    fleet.setGoal(i, 1.0 + 0.001 * i, -1.0 + 0.002 * i);
+
+  for (auto _ : state) {
+    fleet.step(0.01);
+    benchmark::DoNotOptimize(fleet.throttles());
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_Fleet_Step)->RangeMultiplier(8)->Range(8, 4096);
+
+/* @brief Step the same fleet as individual Controllers. */
+static void BM_Fleet_ControllerSteps(benchmark::State& state) {
+  const std::size_t size = state.range(0);
+  const auto params = fleetParams();
+  std::vector<std::unique_ptr<Controller>> controllers;
+  for (std::size_t i = 0; i != size; ++i) {
+    controllers.emplace_back(new Controller(params));
+    controllers.back()->setGoal(1.0 + 0.001 * i, -1.0 + 0.002 * i);
+  }
+
+  for (auto _ : state) {
+    for (auto& controller : controllers)
+      controller->step(0.01);
+  }
+  state.SetItemsProcessed(state.iterations() * size);
+}
+BENCHMARK(BM_Fleet_ControllerSteps)->RangeMultiplier(8)->Range(8, 4096);
@@ -0,0 +1,84 @@
+/* @file Limits.cpp
+ * @brief Microbenchmarks of the kinematic limits.
+ *
+ * @copyright [2020]
+ */
+#include <benchmark/benchmark.h>
+
+#include <cmath>
+#include <memory>
+
+#include <Limits.hpp>
+#include <Params.hpp>
+
+using ackermann::Limits;
+using ackermann::Params;
+using ackermann::ParamsSnapshot;
+
+namespace {
+
+std::shared_ptr<Params> makeParams() {
+  auto params = std::make_shared<Params>(0.45, 0.5, 0.785, 1.0, 1.0);
+  params->angular_velocity_max = 2.0;
+  params->angular_velocity_min = -2.0;
+  params->angular_acceleration_max = 10.0;
+  params->angular_acceleration_min = -10.0;
+  return params;
+}
+
+}  // namespace
+
+/* @brief Bound a heading; the argument is the heading in multiples of pi. */
+static void BM_Limits_BoundHeading(benchmark::State& state) {
+  Limits limits(makeParams());
+  double heading = state.range(0) * M_PI + 0.5;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(heading);
+    benchmark::DoNotOptimize(limits.boundHeading(heading));
+  }
+}
+// from already bounded up to very large (e.g. accumulated) headings
+BENCHMARK(BM_Limits_BoundHeading)->Arg(0)->Arg(4)->Arg(1000)->Arg(1000000);
+
+/* @brief Limit a command which is already within every limit. */
+static void BM_Limits_Limit(benchmark::State& state) {
+  Limits limits(makeParams());
+  const ParamsSnapshot params = makeParams()->snapshot();
+  for (auto _ : state) {
+    double throttle = 0.31, steering = 0.005, steering_vel;
+    limits.limit(params, 3.0, 0.0, 0.0, throttle, steering, steering_vel,
+                 0.01);
+    benchmark::DoNotOptimize(throttle);
+    benchmark::DoNotOptimize(steering);
+    benchmark::DoNotOptimize(steering_vel);
+  }
+}
+BENCHMARK(BM_Limits_Limit);
+
+/* @brief Limit a command which violates every limit. */
+static void BM_Limits_LimitSaturated(benchmark::State& state) {
+  Limits limits(makeParams());
+  const ParamsSnapshot params = makeParams()->snapshot();
+  for (auto _ : state) {
+    double throttle = 5.0, steering = 3.0, steering_vel;
+    limits.limit(params, 0.0, 0.0, 0.0, throttle, steering, steering_vel,
+                 0.01);
+    benchmark::DoNotOptimize(throttle);
+    benchmark::DoNotOptimize(steering);
+    benchmark::DoNotOptimize(steering_vel);
+  }
+}
+BENCHMARK(BM_Limits_LimitSaturated);
+
+/* @brief Limit a command, loading the shared parameters each call. */
+static void BM_Limits_LimitShared(benchmark::State& state) {
+  Limits limits(makeParams());
+  for (auto _ : state) {
+    double throttle = 0.31, steering = 0.005, steering_vel;
+    limits.limit(3.0, 0.0, 0.0, throttle, steering, steering_vel, 0.01);
+    benchmark::DoNotOptimize(throttle);
+    benchmark::DoNotOptimize(steering);
+    benchmark::DoNotOptimize(steering_vel);
+  }
+}
+BENCHMARK(BM_Limits_LimitShared);
@@ -0,0 +1,118 @@
+/* @file Model.cpp
+ * @brief Microbenchmarks of the Ackermann vehicle model.
+ *
+ * @copyright [2020]
+ */
+#include <benchmark/benchmark.h>
+
+#include <atomic>
+#include <memory>
+
+#include <Model.hpp>
+#include <Params.hpp>
+
+using ackermann::Model;
+using ackermann::Params;
+using ackermann::ParamsSnapshot;
+
+/* @brief Simulate a single command. */
+static void BM_Model_Command(benchmark::State& state) {
+  auto params = std::make_shared<Params>(0.45, 0.5, 0.785, 1.0, 1.0);
+  const ParamsSnapshot snapshot = params->snapshot();
+  Model model(params);
+  double steering = 0.1;
+  for (auto _ : state) {
+    model.command(snapshot, 0.3, steering, 0.01);
+    steering = -steering;
+  }
+}
+BENCHMARK(BM_Model_Command);
+
+/* @brief Simulate a single command, in single precision. */
+static void BM_Model_CommandFloat(benchmark::State& state) {
+  auto params = std::make_shared<Params>(0.45, 0.5, 0.785, 1.0, 1.0);
+  const ParamsSnapshot snapshot = params->snapshot();
+  ackermann::BasicModel<float> model(params);
+  float steering = 0.1f;
+  for (auto _ : state) {
+    model.command(snapshot, 0.3f, steering, 0.01f);
+    steering = -steering;
+  }
+}
+BENCHMARK(BM_Model_CommandFloat);
+
+/* @brief Calculate wheel speeds; the argument selects a turning command. */
+static void BM_Model_GetWheelLinVel(benchmark::State& state) {
+  auto params = std::make_shared<Params>(0.45, 0.5, 0.785, 1.0, 1.0);
+  Model model(params);
+  model.setState(3.0, 0.0);
+  model.command(0.3, state.range(0) ? 0.2 : 0.0, 0.01);
+  for (auto _ : state) {
+    double lf, rf, lr, rr;
+    model.getWheelLinVel(lf, rf, lr, rr);
+    benchmark::DoNotOptimize(lf);
+    benchmark::DoNotOptimize(rf);
+    benchmark::DoNotOptimize(lr);
+    benchmark::DoNotOptimize(rr);
+  }
+}
+// straight, then turning
+BENCHMARK(BM_Model_GetWheelLinVel)->Arg(0)->Arg(1);
+
+/* @brief Concurrent use of a model, one thread per role: thread 0 publishes
+ * states (sensor), thread 1 commands (control) and any others read (clients).
+ */
+static void BM_Model_Contention(benchmark::State& state) {
+  static auto params = std::make_shared<Params>(0.45, 0.5, 0.785, 1.0, 1.0);
+  static const ParamsSnapshot snapshot = params->snapshot();
+  static Model model(params);
+  double value = 0.1;
+  for (auto _ : state) {
+    if (state.thread_index() == 0) {
+      model.setState({value, value, ackermann::Clock::time_point()});
+    } else if (state.thread_index() == 1) {
+      model.command(snapshot, 0.3, value, 0.01);
+    } else {
+      double throttle, steering;
+      model.getCommand(throttle, steering);
+      benchmark::DoNotOptimize(throttle);
+      benchmark::DoNotOptimize(steering);
+    }
+    value = -value;
+  }
+}
+BENCHMARK(BM_Model_Contention)->Threads(2)->Threads(3)->UseRealTime();
+
+namespace {
+
+// the fields written by the sensor and control threads, stored together (as
+// they once were in Model) or on separate cache lines (as they are now)
+struct PackedFields {
+  std::atomic<double> state[2];
+  std::atomic<double> command[3];
+};
+
+struct SplitFields {
+  alignas(64) std::atomic<double> state[2];
+  alignas(64) std::atomic<double> command[3];
+};
+
+}  // namespace
+
+/* @brief Two threads each writing their own fields; the cost of sharing a
+ * cache line (only measurable with at least two cores). */
+template <typename Fields>
+static void BM_Model_FalseSharing(benchmark::State& state) {
+  static Fields fields;
+  std::atomic<double>& field = state.thread_index() == 0 ? fields.state[0]
+                                                         : fields.command[0];
+  double value = 0.0;
+  for (auto _ : state) {
+    field.store(value, std::memory_order_release);
+    value += 1.0;
+  }
+}
+BENCHMARK_TEMPLATE(BM_Model_FalseSharing, PackedFields)
+  ->Threads(2)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_Model_FalseSharing, SplitFields)
+  ->Threads(2)->UseRealTime();
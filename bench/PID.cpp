@@ -0,0 +1,61 @@
+/* @file PID.cpp
+ * @brief Microbenchmarks of the PID controller.
+ *
+ * @copyright [2020]
+ */
+#include <benchmark/benchmark.h>
+
+#include <memory>
+
+#include <PID.hpp>
+
+using ackermann::PID;
+using ackermann::PIDGains;
+using ackermann::PIDParams;
+
+/* @brief Unsaturated output, gains loaded from the shared parameters. */
+static void BM_PID_GetCommand(benchmark::State& state) {
+  PID pid(std::make_shared<PIDParams>(1.0, 0.5, 0.1), -1.0, 1.0);
+  double error = 0.1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pid.getCommand(error, 0.01));
+    error = -error;
+  }
+}
+BENCHMARK(BM_PID_GetCommand);
+
+/* @brief Unsaturated output, with snapshot gains. */
+static void BM_PID_GetCommandGains(benchmark::State& state) {
+  PID pid(std::make_shared<PIDParams>(), -1.0, 1.0);
+  const PIDGains gains {1.0, 0.5, 0.1};
+  double error = 0.1;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pid.getCommand(error, 0.01, gains));
+    error = -error;
+  }
+}
+BENCHMARK(BM_PID_GetCommandGains);
+
+/* @brief Output saturated every call (anti windup active). */
+static void BM_PID_GetCommandSaturated(benchmark::State& state) {
+  PID pid(std::make_shared<PIDParams>(), -1.0, 1.0);
+  const PIDGains gains {100.0, 50.0, 10.0};
+  double error = 10.0;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pid.getCommand(error, 0.01, gains));
+    error = -error;
+  }
+}
+BENCHMARK(BM_PID_GetCommandSaturated);
+
+/* @brief Unsaturated output, in single precision. */
+static void BM_PID_GetCommandFloat(benchmark::State& state) {
+  ackermann::BasicPID<float> pid(std::make_shared<PIDParams>(), -1.0f, 1.0f);
+  const PIDGains gains {1.0, 0.5, 0.1};
+  float error = 0.1f;
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(pid.getCommand(error, 0.01f, gains));
+    error = -error;
+  }
+}
+BENCHMARK(BM_PID_GetCommandFloat);
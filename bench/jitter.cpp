@@ -0,0 +1,129 @@
+/* @file jitter.cpp
+ * @brief Measure the wakeup jitter of a periodic thread, with and without
+ * the real-time options of the control thread.
+ *
+ * Usage: jitter [wakeups] [competitors]
+ *
+ * A thread wakes at 100 Hz with sleep_until (as the control loop does),
+ * recording how late each wakeup is, while the given number of threads
+ * (default 2) busy-loop on CPU 0. Both runs pin the thread to CPU 0, so that
+ * only scheduling and memory locking differ: first with the default policy,
+ * then with SCHED_FIFO 80, mlockall and 256 KiB of pre-faulted stack (which
+ * requires CAP_SYS_NICE and CAP_IPC_LOCK, or a suitable rtprio / memlock
+ * limit).
+ *
+ * @copyright [2020]
+ */
+
+#include <pthread.h>
+#include <sched.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <Realtime.hpp>
+
+using ackermann::RealtimeOptions;
+using ackermann::RealtimeStatus;
+using std::chrono::steady_clock;
+
+namespace {
+
+constexpr auto kPeriod = std::chrono::milliseconds(10);
+
+void pinToFirstCpu() {
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(0, &set);
+  pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+}
+
+// return the lateness (us) of each of the given number of wakeups
+std::vector<double> measure(const RealtimeOptions& options,
+                            const int wakeups,
+                            RealtimeStatus& status) {
+  std::vector<double> lateness;
+  lateness.reserve(wakeups);
+  std::thread thread([&]() {
+    status = ackermann::applyRealtimeOptions(options);
+    auto deadline = steady_clock::now() + kPeriod;
+    for (int i = 0; i != wakeups; ++i, deadline += kPeriod) {
+      std::this_thread::sleep_until(deadline);
+      const std::chrono::duration<double, std::micro> late =
+        steady_clock::now() - deadline;
+      lateness.push_back(late.count());
+    }
+  });
+  thread.join();
+  std::sort(lateness.begin(), lateness.end());
+  return lateness;
+}
+
+void report(const char* name,
+            const RealtimeStatus& status,
+            const std::vector<double>& lateness) {
+  const auto percentile = [&lateness](const double quantile) {
+    return lateness[static_cast<std::size_t>(quantile * (lateness.size() - 1))];
+  };
+  const auto over = lateness.end()
+    - std::upper_bound(lateness.begin(), lateness.end(), 1000.0);
+  std::cout << std::setw(10) << name << ": p50 " << std::setw(6)
+            << percentile(0.5) << "us, p99 " << std::setw(6)
+            << percentile(0.99) << "us, max " << std::setw(6)
+            << lateness.back() << "us, " << over << " wakeups > 1ms late";
+  if (!status.ok())
+    std::cout << " (failed: scheduler " << std::strerror(status.scheduler_error)
+              << ", affinity " << std::strerror(status.affinity_error)
+              << ", mlockall " << std::strerror(status.lock_memory_error)
+              << ")";
+  std::cout << std::endl;
+}
+
+}  // namespace
+
+int main(int argc, char *argv[]) {
+  const int wakeups = argc > 1 ? std::atoi(argv[1]) : 1000;
+  const int competitors = argc > 2 ? std::atoi(argv[2]) : 2;
+  if (wakeups <= 0 || competitors < 0) {
+    std::cerr << "Usage: " << argv[0] << " [wakeups] [competitors]"
+              << std::endl;
+    return 2;
+  }
+
+  // load the first CPU
+  std::atomic<bool> done {false};
+  std::vector<std::thread> load;
+  for (int i = 0; i != competitors; ++i)
+    load.emplace_back([&done]() {
+      pinToFirstCpu();
+      while (!done.load(std::memory_order_relaxed)) {}
+    });
+
+  std::cout << std::fixed << std::setprecision(0) << wakeups
+            << " wakeups at 100Hz, " << competitors
+            << " competitors on CPU 0" << std::endl;
+  RealtimeStatus status;
+  RealtimeOptions options;
+  options.cpus = {0};
+  const std::vector<double> defaults = measure(options, wakeups, status);
+  report("default", status, defaults);
+
+  options.policy = RealtimeOptions::Policy::Fifo;
+  options.priority = 80;
+  options.lock_memory = true;
+  options.prefault_stack = 256 * 1024;
+  const std::vector<double> realtime = measure(options, wakeups, status);
+  report("realtime", status, realtime);
+
+  done = true;
+  for (auto& thread : load)
+    thread.join();
+  return 0;
+}
@@ -0,0 +1,95 @@
+#pragma once
+
+/**
+ * @file Angle.hpp
+ * @brief Constant time angle wrapping.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <cmath>
+#include <cstddef>
+#include <limits>
+
+namespace ackermann {
+
+/**
+* @brief Magnitude beyond which angles are rejected by wrapAngle().
+ *
+ * Doubles this large are spaced 1/16 rad apart, i.e. they no longer
+ * represent a meaningful direction.
+ */
+constexpr double kMaxWrapAngle = 281474976710656.0;  // 2^48
+
+/**
+* @brief Magnitude beyond which single precision angles are rejected by
+* wrapAngle(); floats this large are also spaced 1/16 rad apart.
+*/
+constexpr float kMaxWrapAngleFloat = 524288.0f;  // 2^19
+
+/**
+* @brief Per type constants of wrapAngle().
+ *
+ * Adding and subtracting kRound (1.5 * 2^mantissa bits) rounds (to
+ * nearest, even) any smaller magnitude value to a whole number without a
+ * library call, which keeps wrapAngle() branch free and vectorizable.
+ */
+template <typename Scalar>
+struct WrapAngleTraits;
+
+template <>
+struct WrapAngleTraits<double> {
+  static constexpr double kRound = 6755399441055744.0;  // 1.5 * 2^52
+  static constexpr double kMax = kMaxWrapAngle;
+};
+
+template <>
+struct WrapAngleTraits<float> {
+  static constexpr float kRound = 12582912.0f;  // 1.5 * 2^23
+  static constexpr float kMax = kMaxWrapAngleFloat;
+};
+
+/**
+* @brief Wrap an angle to [-pi, pi) in constant time.
+ *
+ * All arithmetic is in the given Scalar type, and the range is that of the
+ * Scalar type's pi, i.e. the result is always less than Scalar(M_PI).
+ * Angles already within range are returned unchanged. Non-finite angles
+ * (NaN, +/-inf), and angles whose magnitude is at least kMaxWrapAngle (or
+ * kMaxWrapAngleFloat), return NaN.
+ *
+ * @param angle: The angle to wrap (rad).
+ * @return The equivalent angle in [-pi, pi), or NaN.
+ */
+template <typename Scalar>
+inline Scalar wrapAngle(const Scalar angle) {
+  constexpr Scalar pi = static_cast<Scalar>(M_PI);
+  constexpr Scalar kRound = WrapAngleTraits<Scalar>::kRound;
+  // round to the nearest whole number of turns
+  const Scalar turns = (angle * (Scalar(0.5) / pi) + kRound) - kRound;
+  Scalar wrapped = angle - turns * (2 * pi);
+  // correct the half open boundaries (candidates computed unconditionally,
+  // and exactly: each is within a factor of two of 2 * pi)
+  const Scalar below = wrapped + 2 * pi;
+  const Scalar above = wrapped - 2 * pi;
+  wrapped = wrapped < -pi ? below : wrapped;
+  wrapped = wrapped >= pi ? above : wrapped;
+  // (false for NaN as well as for large and infinite values)
+  return std::abs(angle) < WrapAngleTraits<Scalar>::kMax
+    ? wrapped : std::numeric_limits<Scalar>::quiet_NaN();
+}
+
+/**
+* @brief Wrap an array of angles to [-pi, pi); equivalent to calling
+* wrapAngle() on each element, but vectorized.
+ *
+ * @param angles: Input array of n angles (rad).
+ * @param wrapped: Output array of n angles; may be the same as angles.
+ * @param n: Number of angles.
+ */
+void wrapAngles(const double* angles, double* wrapped, const std::size_t n);
+
+}  // namespace ackermann
@@ -0,0 +1,96 @@
+#pragma once
+
+/**
+ * @file CommandHistory.hpp
+ * @brief Fixed size history of applied commands, used to compensate for
+ * sensor latency.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <array>
+#include <cstddef>
+
+#include "Samples.hpp"
+
+namespace ackermann {
+
+/**
+* @brief The most recent commands applied by the control loop, expressed as
+* the motion they produce (see Model::command()).
+ *
+ * A measurement which arrives late describes the vehicle as it was before
+ * the latest commands took effect; predict() rolls it forward through those
+ * commands to the present. This is owned by the control loop and is not
+ * thread safe.
+ */
+class CommandHistory {
+ public:
+  /**
+  * @brief Number of commands retained; 640ms at the default control
+  * frequency.
+  */
+  static constexpr std::size_t kCapacity = 64;
+
+  /**
+  * @brief Record an applied command, replacing the oldest if full.
+   *
+   * @param stamp: Time at which the command took effect.
+   * @param dt: Time over which the command was applied (s).
+   * @param speed: The resulting vehicle speed (m/s).
+   * @param heading_rate: The resulting rate of turn (rad/s).
+   */
+  void push(const Clock::time_point stamp,
+            const double dt,
+            const double speed,
+            const double heading_rate);
+
+  /**
+  * @brief Discard every recorded command.
+  */
+  void clear();
+
+  /**
+  * @brief Return the number of recorded commands.
+  */
+  std::size_t size() const;
+
+  /**
+  * @brief Predict the current state from a (possibly late) measurement.
+   *
+   * The heading is advanced by the turn of every command applied between
+   * the measurement and now, and the speed by the change in commanded
+   * speed over the same interval. Commands older than the history are
+   * unknown, so a measurement older than the history is only partially
+   * compensated.
+   *
+   * @param measured: The measurement (stamped when it was measured).
+   * @param now: The time to predict the state at.
+   * @return The predicted state (retaining the measurement's stamp).
+   */
+  StateSample predict(const StateSample& measured,
+                      const Clock::time_point now) const;
+
+ private:
+  /**
+  * @brief A single applied command.
+  */
+  struct Entry {
+    Clock::time_point stamp;
+    Clock::duration dt;
+    double speed;
+    double heading_rate;
+  };
+
+  /**
+  * @brief Ring of recorded commands; the oldest is at next_ once full.
+  */
+  std::array<Entry, kCapacity> entries_;
+  std::size_t size_ {0};
+  std::size_t next_ {0};
+};
+
+}  // namespace ackermann
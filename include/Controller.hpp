@@ -15,11 +15,27 @@
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <utility>
+#include <vector>
 
 #include "Params.hpp"
 #include "Model.hpp"
 #include "PID.hpp"
 #include "Limits.hpp"
+#include "Samples.hpp"
+#include "Realtime.hpp"
+#include "Executor.hpp"
+#include "TimingStats.hpp"
+#include "StageProfiler.hpp"
+#include "Telemetry.hpp"
+#include "Trajectory.hpp"
+#include "CommandHistory.hpp"
+#include "FlightRecorder.hpp"
+#include "Notifier.hpp"
+#include "SeqLock.hpp"
 
 /**
 * @brief Namespace for Ackermann controller implementation
@@ -30,22 +46,77 @@ namespace ackermann {
    * @brief Implementation of a steering and speed controller for a rover
    * with an Ackermann steering mechanism.
    *
+   * All state is allocated on construction: once started, the control loop
+   * performs no heap allocation. Nor does it copy a shared_ptr: the shared
+   * parameters and recorder are only owned through them, and used through
+   * raw references. See ControllerBlock to allocate a controller and its
+   * parameters at once (without any reference count at all).
    */
 class Controller {
  public:
+  /**
+  * @brief Function invoked with every new command; see subscribe().
+  */
+  using CommandCallback = std::function<void(const CommandSample&)>;
+
   /**
   * @brief Constructor; constructs and initializes parameters of all composition classes.
   * @param params Shared pointer detailing rover characteristic parameters
+  * @param telemetry_capacity Number of telemetry records buffered (a power
+  * of two, e.g. kDefaultTelemetryCapacity), or 0 to disable telemetry; see
+  * drainTelemetry().
+  * @throws std::invalid_argument if the capacity isn't a power of two.
   */
-  explicit Controller(const std::shared_ptr<const Params>& params);
+  explicit Controller(const std::shared_ptr<const Params>& params,
+                      const std::size_t telemetry_capacity = 0);
 
   ~Controller();
 
   /**
   * @brief Begin execution of a control loop.
-  */
+   *
+   * Without an Executor (see setExecutor()) this spawns a dedicated thread;
+   * the configured RealtimeOptions are applied by the new thread before
+   * this returns; see getRealtimeStatus() for the outcome.
+   */
   void start();
 
+  /**
+  * @brief Execute the control loop on the given Executor's worker threads
+  * instead of a dedicated thread.
+   *
+   * This takes effect on the next call to start(). The Executor's own
+   * RealtimeOptions then apply, rather than setRealtimeOptions().
+   *
+   * @param executor: The executor to use, or nullptr for a dedicated thread.
+   */
+  void setExecutor(const std::shared_ptr<Executor>& executor);
+
+  /**
+  * @brief Configure how the control loop thread is executed.
+   *
+   * This takes effect on the next call to start().
+   *
+   * @param options: Scheduling, affinity and memory settings.
+   */
+  void setRealtimeOptions(const RealtimeOptions& options);
+
+  /**
+  * @brief Return the outcome of applying the RealtimeOptions during the
+  * latest call to start().
+  */
+  RealtimeStatus getRealtimeStatus() const;
+
+  /**
+  * @brief Return the timing statistics of the running (or latest) control
+  * loop.
+   *
+   * This never blocks the control loop and may be called from any thread;
+   * statistics are cleared on each call to start(). Use a TimingLogger to
+   * report problems.
+   */
+  TimingStats getTimingStats() const;
+
   /** @brief Stop execution of a control loop and rejoin.
    * This also calls reset() to clear any state variables.
    *
@@ -59,7 +130,54 @@ class Controller {
   void reset();
 
   /**
-   * @brief Return true if the core execution thread is running.
+   * @brief Execute a single iteration of the control loop on the calling
+   * thread.
+   *
+   * This runs exactly one pass of the PID, limiting and model update
+   * pipeline without spawning a thread or sleeping, so simulations can
+   * drive the controller in lockstep (and faster than real time). Given the
+   * same inputs the results are identical from run to run. This must not be
+   * called while the asynchronous control loop is running.
+   *
+   * @param dt: The time step to execute over (s).
+   */
+  void step(const double dt);
+
+  /**
+   * @brief Execute a single iteration of the control loop on the calling
+   * thread, at the given (e.g. simulated) time.
+   *
+   * This is identical to step(dt), except that any trajectory is sampled,
+   * and the telemetry and command are stamped, at the given time rather
+   * than the current time.
+   *
+   * @param dt: The time step to execute over (s).
+   * @param now: The time of this iteration.
+   */
+  void step(const double dt, const Clock::time_point now);
+
+  /**
+   * @brief Execute a single iteration of the control loop on the calling
+   * thread, at the given time and with the given feed-forward.
+   *
+   * This is identical to step(dt, now), except that the given feed-forward
+   * is applied in place of that of any trajectory (regardless of
+   * setFeedForward()); Replay uses this to reproduce recorded iterations
+   * exactly.
+   *
+   * @param dt: The time step to execute over (s).
+   * @param now: The time of this iteration.
+   * @param throttle_feed_forward: Added to the throttle command.
+   * @param steering_feed_forward: Added to the steering command (rad).
+   */
+  void step(const double dt,
+            const Clock::time_point now,
+            const double throttle_feed_forward,
+            const double steering_feed_forward);
+
+  /**
+   * @brief Return true if the control loop is running (on its own thread
+   * or an Executor).
    * This is a useful utility for testing.
    *
    * @returns: Whether or not the core control loop is executing.
@@ -75,8 +193,45 @@ class Controller {
    *
    * @param heading: The actual vehicle heading (rad)
    * @param speed: The actual vehicle speed (m/s).
+   * @return False if the state was rejected (see below).
    */
-  void setState(const double speed, const double heading);
+  bool setState(const double speed, const double heading);
+
+  /**
+   * @brief Set the current state of the system, along with the time at
+   * which it was measured.
+   *
+   * Speed and heading are published together, so the control loop never
+   * observes a new speed paired with an old heading. This may be called by
+   * one thread at a time (e.g. a sensor, or a SharedServer), and the loop
+   * never waits on it: a measurement still being written when an
+   * iteration begins is consumed by the next one.
+   *
+   * Non-finite measurements (e.g. from a faulty sensor) are rejected and
+   * leave the current state unchanged.
+   *
+   * With latency compensation enabled (see setLatencyCompensation()) the
+   * state isn't updated immediately: the next iteration rolls the
+   * measurement forward from state.stamp to its own tick time instead.
+   *
+   * @param state: The actual vehicle state.
+   * @return False if the state was rejected.
+   */
+  bool setState(const StateSample& state);
+
+  /**
+  * @brief Enable compensation of sensor latency.
+   *
+   * When enabled, every iteration predicts the current state from the
+   * latest measurement by replaying the commands applied since it was
+   * measured (see CommandHistory), rather than treating a late measurement
+   * as the current state. Measurements must then be stamped with the time
+   * they were taken (in the same time base as the control loop). Disabled
+   * by default.
+   *
+   * @param enable: Whether to compensate for latency.
+   */
+  void setLatencyCompensation(const bool enable);
 
   /**
    * @brief Get the current state (speed, heading) of the system; return
@@ -87,6 +242,13 @@ class Controller {
    */
   void getState(double& speed, double& heading) const;
 
+  /**
+   * @brief Get a consistent copy of the current state of the system.
+   *
+   * @param state: The estimated vehicle state.
+   */
+  void getState(StateSample& state) const;
+
   /**
    * @brief Set the current system setpoint (speed, heading).
    *
@@ -96,8 +258,65 @@ class Controller {
    *
    * @param heading: The desired vehicle heading (rad).
    * @param speed: The desired vehicle speed (m/s).
+   * @return False if the setpoint was rejected (see below).
+   */
+  bool setGoal(const double speed, const double heading);
+
+  /**
+   * @brief Set the current system setpoint, along with the time at which
+   * it was issued.
+   *
+   * Non-finite setpoints are rejected and leave the current setpoint
+   * unchanged. As with setState(), this may be called by one thread at a
+   * time, and the loop never waits on it.
+   *
+   * @param goal: The desired vehicle state.
+   * @return False if the setpoint was rejected.
+   */
+  bool setGoal(const GoalSample& goal);
+
+  /**
+  * @brief Append a knot to the setpoint trajectory.
+   *
+   * Instead of calling setGoal() at a high rate, a whole motion profile may
+   * be uploaded as knots (setpoints stamped with the time they should be
+   * reached). Every iteration samples the trajectory at its exact tick time
+   * (see Trajectory) and uses the result as the setpoint, overriding
+   * setGoal() until clearTrajectory() is called. This never blocks or
+   * allocates, and may be called while running, but only from one thread
+   * at a time.
+   *
+   * @param knot: The setpoint to reach, at knot.stamp.
+   * @return False if the knot was rejected (see Trajectory::append()).
+   */
+  bool appendTrajectory(const GoalSample& knot);
+
+  /**
+  * @brief Append a sequence of knots to the setpoint trajectory.
+   *
+   * @param knots: Array of knots, in order.
+   * @param count: Number of knots.
+   * @return The number of knots appended.
+   */
+  std::size_t appendTrajectory(const GoalSample* knots,
+                               const std::size_t count);
+
+  /**
+  * @brief Discard the setpoint trajectory; the latest setpoint is retained.
+  */
+  void clearTrajectory();
+
+  /**
+  * @brief Enable feed-forward of the trajectory's rates of change.
+   *
+   * When enabled, the speed rate is added to the throttle command and the
+   * steering angle which produces the heading rate (at the current speed)
+   * is added to the steering command, so the PIDs only correct tracking
+   * error. Disabled by default.
+   *
+   * @param enable: Whether to apply feed-forward.
    */
-  void setGoal(const double speed, const double heading);
+  void setFeedForward(const bool enable);
 
   /**
   *  @brief Get the current system setpoint (speed, heading); return as
@@ -108,6 +327,13 @@ class Controller {
    */
   void getGoal(double& speed, double& heading) const;
 
+  /**
+  *  @brief Get a consistent copy of the current system setpoint.
+   *
+   * @param goal: The current vehicle setpoint.
+   */
+  void getGoal(GoalSample& goal) const;
+
   /**
   * @brief Get the current system command (speed, heading); return as
   * parameters specified.
@@ -122,6 +348,60 @@ class Controller {
    */
   void getCommand(double& throttle, double& steering) const;
 
+  /**
+  * @brief Get a consistent copy of the latest command.
+   *
+   * @param command: The latest command (with a sequence of 0 if none has
+   * been produced yet).
+   */
+  void getCommand(CommandSample& command) const;
+
+  /**
+  * @brief Block until a command newer than the given sequence number is
+  * produced (or the timeout expires).
+   *
+   * This returns as soon as the control loop publishes the command, so
+   * clients don't need to poll getCommand(). Any number of threads may
+   * wait concurrently. A typical client loop is:
+   *
+   *   CommandSample command;
+   *   while (controller.waitForCommand(command.sequence, command, timeout))
+   *     actuate(command);
+   *
+   * @param after: Sequence number of the last command seen by the caller.
+   * @param command: (Return parameter) The latest command.
+   * @param timeout: Maximum time to wait; Clock::duration::max() waits
+   * indefinitely.
+   * @return False on timeout (command then holds the latest, not newer,
+   * command).
+   */
+  bool waitForCommand(const uint64_t after,
+                      CommandSample& command,
+                      const Clock::duration timeout) const;
+
+  /**
+  * @brief Register a function to be called with every new command.
+   *
+   * Callbacks are executed on the control thread immediately after each
+   * command is produced, so they MUST NOT block (no locks, I/O or memory
+   * allocation) and should be short: they delay the control loop. Use
+   * waitForCommand() for anything more involved.
+   *
+   * @param callback: The function to call.
+   * @return An identifier to pass to unsubscribe().
+   */
+  std::size_t subscribe(CommandCallback callback);
+
+  /**
+  * @brief Remove a function registered by subscribe().
+   *
+   * A callback executing concurrently with this call may complete after
+   * it returns, but no new invocations are started.
+   *
+   * @param id: The identifier returned by subscribe().
+   */
+  void unsubscribe(const std::size_t id);
+
   /**
   * @brief Get the current system wheel speeds; return as parameters specified.
    *
@@ -135,38 +415,225 @@ class Controller {
                       double& left_rear,
                       double& right_rear) const;
 
+  /**
+  * @brief Retrieve the telemetry recorded since the previous call.
+   *
+   * When enabled at construction, every control loop iteration (and
+   * step()) produces one record; these are buffered (up to
+   * getTelemetryCapacity()) until drained. Only a single thread may drain
+   * at a time.
+   *
+   * @param records: Array receiving the oldest records, in order.
+   * @param max: The size of the records array.
+   * @return The number of records retrieved.
+   */
+  std::size_t drainTelemetry(TelemetryRecord* records, const std::size_t max);
+
+  /**
+  * @brief Return the number of telemetry records discarded because they
+  * weren't drained in time.
+  */
+  uint64_t getTelemetryDropped() const;
+
+  /**
+  * @brief Return the number of telemetry records buffered (0 if telemetry
+  * is disabled).
+  */
+  std::size_t getTelemetryCapacity() const;
+
+#ifdef ACKERMANN_PROFILE_STAGES
+  /**
+  * @brief Return the per-stage profile of every iteration.
+   *
+   * Only available when built with ACKERMANN_PROFILE_STAGES (the CMake
+   * option PROFILE_STAGES). Statistics are cleared on each call to
+   * start(); only a single thread may drain timelines at a time.
+   */
+  StageProfiler& getStageProfiler();
+#endif
+
+  /**
+  * @brief Record all inputs (setState, setGoal, reset and parameter
+  * changes) and every iteration's outputs to the given recorder.
+   *
+   * This must not be called concurrently with any other method (i.e. set
+   * it before start()).
+   *
+   * @param recorder: The recorder to use, or nullptr to stop recording.
+   */
+  void setRecorder(const std::shared_ptr<FlightRecorder>& recorder);
+
  private:
+  friend class Executor;
+
   /**
   * @brief Control loop (executed asynchronously)
   */
   void controlLoop();
 
   /**
-  * @brief A copy of our configuration parameters.
+  * @brief Initialize the schedule of the control loop, starting now.
+  */
+  void beginLoop();
+
+  /**
+  * @brief Execute the scheduled control loop iteration, recording its
+  * timing.
+   *
+   * @return The time at which the following iteration is scheduled.
    */
-  const std::shared_ptr<const Params> params_;
+  std::chrono::steady_clock::time_point tick();
+
+  /**
+  * @brief Feed-forward terms of a single iteration.
+  */
+  struct FeedForward {
+    double throttle;
+    double steering;
+  };
+
+  /**
+  * @brief Execute one iteration of the control pipeline.
+  * @param params: Parameter snapshot to use for the entire iteration.
+  * @param dt: The time step to execute over (s).
+  * @param now: The time of this iteration.
+  * @param feed_forward: Feed-forward to apply instead of the trajectory's;
+  * nullptr for the trajectory's (if enabled).
+  */
+  void update(const ParamsSnapshot& params,
+              const double dt,
+              const Clock::time_point now,
+              const FeedForward* feed_forward = nullptr);
+
+  /**
+  * @brief Keeps our configuration parameters alive; everything else
+  * (including the loop) reads them through params_, so it never touches
+  * their reference count.
+   */
+  const std::shared_ptr<const Params> params_owner_;
+  const Params& params_;
 
   /**
   * @brief Object used to apply kinematic constraints to
    * a calculated command (to prevent saturation)
    */
-  std::unique_ptr<Limits> limits_;
+  Limits limits_;
 
   /**
   * @brief Ackermann model (used in translating
    * speed/heading into wheel speeds)
    */
-  std::unique_ptr<Model> model_;
+  Model model_;
 
   /**
   * @brief Internal encapsulated PID controller for system throttle.
   */
-  std::unique_ptr<PID> pid_throttle_;
+  PID pid_throttle_;
 
   /**
   * @brief Internal encapsulated PID controller for system heading.
   */
-  std::unique_ptr<PID> pid_heading_;
+  PID pid_heading_;
+
+  /**
+  * @brief Telemetry produced by the control loop (if enabled).
+  */
+  TelemetryRing telemetry_;
+
+  /**
+  * @brief Setpoint trajectory (sampled by the loop), and whether to feed
+  * its rates forward.
+  */
+  Trajectory trajectory_;
+  std::atomic<bool> feed_forward_ {false};
+
+  /**
+  * @brief Latest measured state (written by the sensor thread) and the
+  * commands applied since (only modified by the loop and reset()), used to
+  * compensate for sensor latency.
+  */
+  SeqLock<StateSample, true> measurement_;
+  CommandHistory history_;
+  std::atomic<bool> latency_compensation_ {false};
+
+  /**
+  * @brief Number of iterations executed (only modified by the loop).
+  */
+  uint64_t tick_ {0};
+
+  /**
+  * @brief The latest command, and the event signalled when it changes.
+  */
+  SeqLock<CommandSample, true> command_;
+  Notifier command_event_;
+
+  /**
+  * @brief Registered command callbacks (by identifier).
+   *
+   * The list is immutable once published; subscribe() and unsubscribe()
+   * replace it (serialized by subscribers_mutex_), so the control thread
+   * only ever loads a plain pointer to the current list. dispatches_ is odd
+   * while the control thread is calling subscribers; replaced lists are
+   * retired until it has (at least) reached the given even count.
+   */
+  using Subscribers = std::vector<std::pair<std::size_t, CommandCallback>>;
+  void publishSubscribers(std::unique_ptr<Subscribers> subscribers);
+  std::atomic<const Subscribers*> subscribers_ {nullptr};
+  std::atomic<uint64_t> dispatches_ {0};
+  std::vector<std::pair<uint64_t, const Subscribers*>> retired_;
+  std::mutex subscribers_mutex_;
+  std::size_t next_subscriber_ {0};
+
+  /**
+  * @brief Optional recorder of our inputs and outputs (kept alive by
+  * recorder_owner_, and used through recorder_).
+  */
+  std::shared_ptr<FlightRecorder> recorder_owner_;
+  FlightRecorder* recorder_ {nullptr};
+
+  /**
+  * @brief The parameters most recently written to recorder_.
+  */
+  ParamsSnapshot recorded_params_;
+  bool params_recorded_ {false};
+
+  /**
+  * @brief Settings applied to the control loop thread.
+  */
+  RealtimeOptions realtime_options_;
+
+  /**
+  * @brief Outcome of applying realtime_options_ (written before start()
+  * returns).
+  */
+  RealtimeStatus realtime_status_;
+
+  /**
+  * @brief Timing instrumentation of the control loop.
+  */
+  TimingRecorder timing_;
+
+#ifdef ACKERMANN_PROFILE_STAGES
+  /**
+  * @brief Per-stage instrumentation of each iteration.
+  */
+  StageProfiler profiler_;
+#endif
+
+  /**
+  * @brief Schedule of the control loop (only modified by the loop).
+  */
+  std::chrono::steady_clock::duration loop_period_ {};
+  std::chrono::steady_clock::time_point next_loop_time_;
+  std::chrono::steady_clock::time_point last_loop_start_;
+  bool first_loop_ {true};
+
+  /**
+  * @brief The executor to run on (if any), and the one currently running
+  * our control loop.
+  */
+  std::shared_ptr<Executor> executor_;
+  std::shared_ptr<Executor> active_executor_;
 
   /**
   * @brief Thread handle for the currently executing control loop.
@@ -175,4 +642,31 @@ class Controller {
   std::atomic<bool> cancel_ {false};
 };
 
+/**
+* @brief A Controller and its parameters, stored in one contiguous block.
+ *
+ * The controller refers to the parameters through non owning pointers, so
+ * allocating a ControllerBlock (e.g. with std::make_unique) is the only
+ * allocation required, and no reference counts are ever modified. The
+ * parameters must be accessed through the block; it must not be moved.
+ */
+struct ControllerBlock {
+  /**
+  * @brief Constructor; see Params.
+  */
+  ControllerBlock(double wheel_base,
+                  double track_width,
+                  double max_steering_angle,
+                  double kp_speed,
+                  double kp_heading);
+
+  ControllerBlock(const ControllerBlock&) = delete;
+  ControllerBlock& operator=(const ControllerBlock&) = delete;
+
+  PIDParams pid_speed;
+  PIDParams pid_heading;
+  Params params;
+  Controller controller;
+};
+
 }  // namespace ackermann
@@ -0,0 +1,154 @@
+#pragma once
+
+/**
+ * @file Executor.hpp
+ * @brief Class declaration for a worker pool executing many controllers.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "Realtime.hpp"
+
+namespace ackermann {
+
+class Controller;
+
+/**
+* @brief Executes the control loops of any number of Controllers on a fixed
+* pool of worker threads.
+ *
+ * Instead of one (mostly sleeping) thread per controller, every scheduled
+ * controller's next tick is kept in a deadline ordered heap; one idle
+ * worker sleeps until the earliest deadline (the rest until they are
+ * needed), executes that controller's tick and reschedules it at its own
+ * control frequency. A controller is only ever executed by one worker at a
+ * time, and scheduling never allocates once the controller is added.
+ *
+ * Ticks are still timed by each Controller, so overruns and missed ticks
+ * are reported per controller through Controller::getTimingStats().
+ *
+ * Controllers are scheduled through Controller::setExecutor() and start(),
+ * and the Executor must outlive them (they hold a shared_ptr to it).
+ */
+class Executor {
+ public:
+  /**
+  * @brief Constructor; starts the worker threads.
+   *
+   * @param workers: Number of worker threads (at least one).
+   * @param options: Settings applied by every worker thread.
+   */
+  explicit Executor(const std::size_t workers = 1,
+                    const RealtimeOptions& options = RealtimeOptions());
+
+  /**
+  * @brief Destructor; stops and joins the worker threads.
+   *
+   * Every controller must have been stopped beforehand.
+   */
+  ~Executor();
+
+  Executor(const Executor&) = delete;
+  Executor& operator=(const Executor&) = delete;
+
+  /**
+  * @brief Return the number of worker threads.
+  */
+  std::size_t workers() const;
+
+  /**
+  * @brief Return the number of controllers currently scheduled.
+  */
+  std::size_t size() const;
+
+  /**
+  * @brief Return the outcome of applying the RealtimeOptions in each
+  * worker thread.
+  */
+  std::vector<RealtimeStatus> getRealtimeStatus() const;
+
+ private:
+  friend class Controller;
+
+  using TimePoint = std::chrono::steady_clock::time_point;
+
+  /**
+  * @brief Begin executing the given controller's ticks, the first at the
+  * given time.
+  */
+  void add(Controller* controller, const TimePoint first);
+
+  /**
+  * @brief Stop executing the given controller.
+   *
+   * @param block: Wait for any tick in progress to complete.
+   */
+  void remove(Controller* controller, const bool block);
+
+  /**
+  * @brief Worker loop (executed asynchronously).
+  */
+  void work();
+
+  /**
+  * @brief The next tick of a scheduled controller.
+   *
+   * The heap holds exactly one entry per scheduled controller which isn't
+   * currently executing; remove() takes entries out immediately.
+   */
+  struct Entry {
+    TimePoint deadline;
+    Controller* controller;
+
+    // (ordered for a min-heap of deadlines)
+    bool operator<(const Entry& other) const {
+      return deadline > other.deadline;
+    }
+  };
+
+  /**
+  * @brief Scheduling state of a single controller.
+  */
+  struct Slot {
+    bool scheduled;  ///< False once removed (while its tick completes).
+    bool busy;       ///< A worker is executing its tick.
+  };
+
+  /**
+  * @brief Add an entry to the heap (with mutex_ held).
+   * @return True if it is now the earliest deadline.
+   */
+  bool schedule(const Entry& entry);
+
+  /**
+  * @brief Wake the worker responsible for the earliest deadline, after it
+  * has changed (with mutex_ held).
+  */
+  void wakeTimer();
+
+  mutable std::mutex mutex_;
+  std::condition_variable timer_;
+  std::condition_variable idle_;
+  std::condition_variable done_;
+  std::vector<Entry> deadlines_;
+  std::unordered_map<Controller*, Slot> slots_;
+  bool timing_ {false};
+  bool cancel_ {false};
+
+  std::vector<RealtimeStatus> realtime_status_;
+  std::vector<std::thread> workers_;
+};
+
+}  // namespace ackermann
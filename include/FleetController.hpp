@@ -0,0 +1,245 @@
+#pragma once
+
+/**
+ * @file FleetController.hpp
+ * @brief Class declaration for a structure-of-arrays controller that steps
+ * an entire fleet of Ackermann vehicles at once.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "Params.hpp"
+
+namespace ackermann {
+
+/**
+* @brief Lockstep controller for a fleet of identical Ackermann vehicles.
+ *
+ * This executes the same math as a single Controller (PID::getCommand,
+ * Limits::limit and Model::command) but keeps the state of every vehicle
+ * in contiguous arrays, so that a single step() performs one branch-free
+ * pass over the whole fleet which the compiler is able to vectorize.
+ *
+ * All vehicles share one set of parameters. This class is not thread safe;
+ * it is intended to be driven synchronously by a simulation or batch loop.
+ */
+class FleetController {
+ public:
+  /**
+  * @brief Constructor; allocates and zero initializes all vehicle state.
+  * @param params Shared pointer detailing rover characteristic parameters
+  * @param size Number of vehicles in the fleet.
+  */
+  FleetController(const std::shared_ptr<const Params>& params,
+                  const std::size_t size);
+
+  /**
+  * @brief Return the number of vehicles in the fleet.
+  */
+  std::size_t size() const;
+
+  /**
+  * @brief Clear system state variables of every vehicle.
+  */
+  void reset();
+
+  /**
+  * @brief Set the current state (speed, heading) of a single vehicle.
+   *
+   * @param index: Vehicle index in [0, size()).
+   * @param speed: The actual vehicle speed (m/s).
+   * @param heading: The actual vehicle heading (rad).
+   * @return False (and the state is left unchanged) if the speed or
+   * heading is not finite.
+   */
+  bool setState(const std::size_t index,
+                const double speed,
+                const double heading);
+
+  /**
+  * @brief Set the current state (speed, heading) of every vehicle.
+   *
+   * @param speeds: Array of size() vehicle speeds (m/s).
+   * @param headings: Array of size() vehicle headings (rad).
+   * Vehicles given non-finite values are left unchanged.
+   */
+  void setStates(const double* speeds, const double* headings);
+
+  /**
+  * @brief Get the current state (speed, heading) of a single vehicle.
+   *
+   * @param index: Vehicle index in [0, size()).
+   * @param speed: The estimated vehicle speed (m/s).
+   * @param heading: The estimated vehicle heading (rad).
+   */
+  void getState(const std::size_t index,
+                double& speed,
+                double& heading) const;
+
+  /**
+  * @brief Set the setpoint (speed, heading) of a single vehicle.
+   *
+   * @param index: Vehicle index in [0, size()).
+   * @param speed: The desired vehicle speed (m/s).
+   * @param heading: The desired vehicle heading (rad).
+   * @return False (and the setpoint is left unchanged) if the speed or
+   * heading is not finite.
+   */
+  bool setGoal(const std::size_t index,
+               const double speed,
+               const double heading);
+
+  /**
+  * @brief Set the setpoint (speed, heading) of every vehicle.
+   *
+   * @param speeds: Array of size() desired vehicle speeds (m/s).
+   * @param headings: Array of size() desired vehicle headings (rad).
+   * Vehicles given non-finite values are left unchanged.
+   */
+  void setGoals(const double* speeds, const double* headings);
+
+  /**
+  * @brief Get the setpoint (speed, heading) of a single vehicle.
+   *
+   * @param index: Vehicle index in [0, size()).
+   * @param speed: The desired vehicle speed (m/s).
+   * @param heading: The desired vehicle heading (rad).
+   */
+  void getGoal(const std::size_t index,
+               double& speed,
+               double& heading) const;
+
+  /**
+  * @brief Get the latest command (throttle, steering) of a single vehicle.
+   *
+   * @param index: Vehicle index in [0, size()).
+   * @param throttle: The latest throttle command (limited between [0,1]).
+   * @param steering: The latest steering angle command (rad).
+   */
+  void getCommand(const std::size_t index,
+                  double& throttle,
+                  double& steering) const;
+
+  /**
+  * @brief Direct read access to the latest throttle commands of every
+  * vehicle (size() elements).
+  */
+  const double* throttles() const;
+
+  /**
+  * @brief Direct read access to the latest steering commands of every
+  * vehicle (size() elements).
+  */
+  const double* steerings() const;
+
+  /**
+  * @brief Calculate the linear velocity at each wheel of every vehicle
+  * (see Model::getWheelLinVel); each output array has size() elements.
+   *
+   * This uses the steering geometry cached by the latest step().
+   *
+   * @param left_front: Left front wheel linear velocities (m/s).
+   * @param right_front: Right front wheel linear velocities (m/s).
+   * @param left_rear: Left rear wheel linear velocities (m/s).
+   * @param right_rear: Right rear wheel linear velocities (m/s).
+   */
+  void getWheelLinVels(double* left_front,
+                       double* right_front,
+                       double* left_rear,
+                       double* right_rear) const;
+
+  /**
+  * @brief Execute a single control iteration for every vehicle.
+   *
+   * @param dt: The time step to execute over (s).
+   */
+  void step(const double dt);
+
+ private:
+  /**
+  * @brief A copy of our configuration parameters.
+  */
+  const std::shared_ptr<const Params> params_;
+
+  /**
+  * @brief Number of vehicles in the fleet.
+  */
+  const std::size_t size_;
+
+  /**
+  * @brief Output limits of the throttle PID controllers (anti windup).
+  */
+  const double throttle_out_min_;
+  const double throttle_out_max_;
+
+  /**
+  * @brief Output limits of the heading PID controllers (anti windup).
+  */
+  const double heading_out_min_;
+  const double heading_out_max_;
+
+  /**
+  * @brief Vehicle geometry used by the latest step().
+  */
+  double wheel_base_ {0.0};
+  double track_width_ {0.0};
+
+  // per vehicle state; one element per vehicle
+  /**
+  * @brief Current (estimated) speed of each vehicle (m/s).
+  */
+  std::vector<double> current_speed_;
+  /**
+  * @brief Current (estimated) heading of each vehicle (rad).
+  */
+  std::vector<double> current_heading_;
+  /**
+  * @brief Desired speed of each vehicle (m/s).
+  */
+  std::vector<double> desired_speed_;
+  /**
+  * @brief Desired heading of each vehicle (rad).
+  */
+  std::vector<double> desired_heading_;
+  /**
+  * @brief Current throttle command of each vehicle.
+  */
+  std::vector<double> current_throttle_;
+  /**
+  * @brief Current steering command of each vehicle (rad).
+  */
+  std::vector<double> current_steering_;
+  /**
+  * @brief Current steering velocity of each vehicle (rad/s).
+  */
+  std::vector<double> current_steering_vel_;
+  /**
+  * @brief Tangent of the current steering command of each vehicle.
+  */
+  std::vector<double> tan_steering_;
+  /**
+  * @brief Throttle PID integral error of each vehicle.
+  */
+  std::vector<double> throttle_integral_;
+  /**
+  * @brief Throttle PID previous error of each vehicle.
+  */
+  std::vector<double> throttle_prev_error_;
+  /**
+  * @brief Heading PID integral error of each vehicle.
+  */
+  std::vector<double> heading_integral_;
+  /**
+  * @brief Heading PID previous error of each vehicle.
+  */
+  std::vector<double> heading_prev_error_;
+};
+
+}  // namespace ackermann
@@ -0,0 +1,196 @@
+#pragma once
+
+/**
+ * @file FlightRecorder.hpp
+ * @brief Memory-mapped binary recording of Controller inputs and outputs.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+#include "Params.hpp"
+#include "Samples.hpp"
+#include "Telemetry.hpp"
+
+namespace ackermann {
+
+/**
+* @brief A single fixed size entry of a flight recording.
+ */
+struct FlightRecord {
+  /**
+  * @brief Kinds of recorded events.
+  */
+  enum Type : uint32_t {
+    Empty = 0,   ///< Unused (or never completed) slot.
+    State = 1,   ///< setState() call; payload is a StateSample.
+    Goal = 2,    ///< setGoal() call; payload is a GoalSample.
+    Reset = 3,   ///< reset() call; no payload.
+    Params = 4,  ///< New parameter values; payload is a ParamsSnapshot.
+    Tick = 5     ///< Control iteration; payload is a TelemetryRecord.
+  };
+
+  /**
+  * @brief Kind of event (written last).
+  */
+  uint32_t type {Empty};
+  uint32_t reserved {0};
+  /**
+  * @brief Time step of a Tick (s).
+  */
+  double dt {0.0};
+  /**
+  * @brief Raw event data.
+  */
+  alignas(8) unsigned char payload[
+    sizeof(TelemetryRecord) > sizeof(ParamsSnapshot)
+      ? sizeof(TelemetryRecord) : sizeof(ParamsSnapshot)];
+
+  /**
+  * @brief Return the payload as the given type.
+  */
+  template <typename T>
+  T get() const {
+    static_assert(std::is_trivially_copyable<T>::value
+                  && sizeof(T) <= sizeof(payload), "invalid payload type");
+    T value;
+    std::memcpy(&value, payload, sizeof(T));
+    return value;
+  }
+};
+
+/**
+* @brief Appends Controller events to a memory-mapped file of fixed size
+* records.
+ *
+ * Appending is lock free and may be done from any number of threads: each
+ * event claims the next slot with a single atomic increment and is copied
+ * straight into the (pre-faulted) mapping, so recording never formats,
+ * allocates or makes a system call. Events beyond the file's capacity are
+ * dropped (and counted). The file is truncated to its used size when the
+ * recorder is destroyed.
+ */
+class FlightRecorder {
+ public:
+  /**
+  * @brief Constructor; creates (or truncates) and maps the given file.
+   *
+   * @param path: Output file.
+   * @param capacity: Maximum number of events to record.
+   * @throws std::system_error if the file can't be created or mapped.
+   */
+  FlightRecorder(const std::string& path, const std::size_t capacity);
+
+  /**
+  * @brief Destructor; finalizes and closes the file.
+  */
+  ~FlightRecorder();
+
+  FlightRecorder(const FlightRecorder&) = delete;
+  FlightRecorder& operator=(const FlightRecorder&) = delete;
+
+  /**
+  * @brief Record a setState() call.
+  */
+  void recordState(const StateSample& state);
+
+  /**
+  * @brief Record a setGoal() call.
+  */
+  void recordGoal(const GoalSample& goal);
+
+  /**
+  * @brief Record a reset() call.
+  */
+  void recordReset();
+
+  /**
+  * @brief Record a change of parameters.
+  */
+  void recordParams(const ParamsSnapshot& params);
+
+  /**
+  * @brief Record a control iteration.
+   *
+   * @param telemetry: Everything computed by the iteration.
+   * @param dt: The time step the iteration executed over (s).
+   */
+  void recordTick(const TelemetryRecord& telemetry, const double dt);
+
+  /**
+  * @brief Return the number of events recorded.
+  */
+  std::size_t size() const;
+
+  /**
+  * @brief Return the number of events dropped because the file was full.
+  */
+  uint64_t dropped() const;
+
+ private:
+  /**
+  * @brief Claim a slot and write a single event to it.
+  */
+  void append(const uint32_t type,
+              const void* payload,
+              const std::size_t size,
+              const double dt = 0.0);
+
+  int fd_ {-1};
+  void* mapping_ {nullptr};
+  std::size_t mapping_size_ {0};
+  FlightRecord* records_ {nullptr};
+  const std::size_t capacity_;
+  std::atomic<uint64_t> next_ {0};
+  std::atomic<uint64_t> dropped_ {0};
+};
+
+/**
+* @brief Read only view of a flight recording.
+ */
+class FlightLog {
+ public:
+  /**
+  * @brief Constructor; maps the given recording.
+   *
+   * @param path: A file written by FlightRecorder.
+   * @throws std::system_error if the file can't be read, or
+   * std::runtime_error if it is not a valid recording.
+   */
+  explicit FlightLog(const std::string& path);
+
+  /**
+  * @brief Destructor; unmaps the file.
+  */
+  ~FlightLog();
+
+  FlightLog(const FlightLog&) = delete;
+  FlightLog& operator=(const FlightLog&) = delete;
+
+  /**
+  * @brief Return the number of record slots (some may be Empty).
+  */
+  std::size_t size() const;
+
+  /**
+  * @brief Return the given record.
+  */
+  const FlightRecord& operator[](const std::size_t index) const;
+
+ private:
+  void* mapping_ {nullptr};
+  std::size_t mapping_size_ {0};
+  const FlightRecord* records_ {nullptr};
+  std::size_t size_ {0};
+};
+
+}  // namespace ackermann
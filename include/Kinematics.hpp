@@ -0,0 +1,70 @@
+#pragma once
+
+/**
+ * @file Kinematics.hpp
+ * @brief Ackermann wheel kinematics shared by the single vehicle and fleet
+ * implementations.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <cmath>
+
+namespace ackermann {
+
+/**
+* @brief Ratio of each wheel's linear velocity to the vehicle speed.
+ *
+ * These depend only on the steering angle and the vehicle geometry, so
+ * they are computed once per command and reused by every wheel speed query.
+ */
+template <typename Scalar>
+struct BasicWheelFactors {
+  /**
+  * @brief Tangent of the steering angle the factors were computed for.
+  */
+  Scalar tan_steering {0};
+  Scalar left_front {1};
+  Scalar right_front {1};
+  Scalar left_rear {1};
+  Scalar right_rear {1};
+};
+
+using WheelFactors = BasicWheelFactors<double>;
+
+/**
+* @brief Calculate the wheel factors for the given steering angle.
+ *
+ * https://www.xarg.org/book/kinematics/ackerman-steering/
+ * With turning radius R = wheel_base / tan(steering), each wheel's speed
+ * is |speed * r / R|, where r is the wheel's distance to the center of the
+ * turning circle. Expressing r / R in terms of tan(steering) removes the
+ * singularity of driving straight (R = inf).
+ *
+ * @param tan_steering: Tangent of the steering angle.
+ * @param wheel_base: Length between front and rear axles (m).
+ * @param track_width: Width between left and right tires (m).
+ */
+template <typename Scalar>
+inline BasicWheelFactors<Scalar> wheelFactors(const Scalar tan_steering,
+                                              const Scalar wheel_base,
+                                              const Scalar track_width) {
+  // rear axle is aligned with radius of turning circle (r = R -/+ width/2)
+  const Scalar offset = tan_steering * track_width / (2 * wheel_base);
+  const Scalar left = 1 + offset;
+  const Scalar right = 1 - offset;
+  // front axle is not aligned; use Pythagoras (r = sqrt(base^2 + rear^2))
+  const Scalar front = tan_steering * tan_steering;
+  BasicWheelFactors<Scalar> f;
+  f.tan_steering = tan_steering;
+  f.left_rear = std::abs(left);
+  f.right_rear = std::abs(right);
+  f.left_front = std::sqrt(front + left * left);
+  f.right_front = std::sqrt(front + right * right);
+  return f;
+}
+
+}  // namespace ackermann
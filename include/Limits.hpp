@@ -5,7 +5,8 @@
 * @brief Class declaration for Limits class
 *
 * Object containing limitations for the Ackermann rover to prevent sending
-* steering or speed commands past allowable bounds.
+* steering or speed commands past allowable bounds. The implementation is
+* defined here (for inlining); Limits is the default instantiation.
 *
 * @author Spencer Elyard
 * @author Daniel M. Sahu
@@ -13,24 +14,48 @@
 * @copyright Copyright [2020] Elyard/Kesani/Sahu
 */
 
+#include <cmath>
 #include <memory>
 #include <limits>
 
 #include "Params.hpp"
+#include "Angle.hpp"
 
 namespace ackermann {
 
+/**
+* @brief Constraint policy: limit commands to their ranges, and to the
+* maximum acceleration, steering velocity and steering acceleration.
+ */
+struct KinematicConstraints {
+  static constexpr bool rates = true;
+};
+
+/**
+* @brief Constraint policy: only limit commands to their ranges (e.g. for
+* actuators which enforce their own rate limits).
+ */
+struct RangeConstraints {
+  static constexpr bool rates = false;
+};
+
 /**
 * @brief Class used to apply known limits to a given desired control signal.
+ *
+ * Commands are computed in the given Scalar type, and constrained according
+ * to the given constraint policy.
  */
-class Limits {
+template <typename Scalar, typename Constraints = KinematicConstraints>
+class BasicLimits {
  public:
    /**
    * @brief Constructor
    * @param params Shared pointer detailing rover characteristic parameters
    */
-  explicit Limits(const std::shared_ptr<const Params>& params);
-  Limits() = delete;
+  explicit BasicLimits(const std::shared_ptr<const Params>& params)
+    : params_(params) {
+  }
+  BasicLimits() = delete;
 
   /**
   * @brief Apply known limits to the given controller command.
@@ -49,13 +74,33 @@ class Limits {
    * (rad/s).
    * @param dt: Fixed time step between commands (s).
   */
-  void limit(const double current_speed,
-             const double current_steering,
-             const double current_steering_vel,
-             double& desired_throttle,
-             double& desired_steering,
-             double& desired_steering_vel,
-             double dt) const;
+  void limit(const Scalar current_speed,
+             const Scalar current_steering,
+             const Scalar current_steering_vel,
+             Scalar& desired_throttle,
+             Scalar& desired_steering,
+             Scalar& desired_steering_vel,
+             Scalar dt) const {
+    limit(params_->snapshot(), current_speed, current_steering,
+          current_steering_vel, desired_throttle, desired_steering,
+          desired_steering_vel, dt);
+  }
+
+  /**
+  * @brief Apply known limits to the given controller command, using the
+  * given parameter snapshot instead of loading our shared parameters.
+   *
+   * @param params: Consistent set of parameters to limit against.
+   * (all other parameters as above)
+  */
+  void limit(const ParamsSnapshot& params,
+             const Scalar current_speed,
+             const Scalar current_steering,
+             const Scalar current_steering_vel,
+             Scalar& desired_throttle,
+             Scalar& desired_steering,
+             Scalar& desired_steering_vel,
+             Scalar dt) const;
 
 /**
 * @brief Use Parameters structure to convert throttle to speed as a
@@ -63,14 +108,32 @@ class Limits {
   * @param throttle Throttle setting in range of generally [0,1]
   * @return Speed based on throttle input (linear relationship) (m/s)
   */
-  double throttleToSpeed(double throttle) const;
+  Scalar throttleToSpeed(Scalar throttle) const {
+    return throttleToSpeed(params_->snapshot(), throttle);
+  }
+  /**
+  * @brief Convert throttle to speed using the given parameter snapshot.
+  * @param params Consistent set of parameters to convert with
+  * @param throttle Throttle setting in range of generally [0,1]
+  * @return Speed based on throttle input (linear relationship) (m/s)
+  */
+  Scalar throttleToSpeed(const ParamsSnapshot& params, Scalar throttle) const;
   /**
   * @brief Use Parameters structure to convert speed to throttle as a
   * function of maximum allowable speed.
   * @param speed Speed in range of [0,max_speed]
   * @return Throttle position estimate from speed (linear relationship) [0,1]
   */
-  double speedToThrottle(double speed) const;
+  Scalar speedToThrottle(Scalar speed) const {
+    return speedToThrottle(params_->snapshot(), speed);
+  }
+  /**
+  * @brief Convert speed to throttle using the given parameter snapshot.
+  * @param params Consistent set of parameters to convert with
+  * @param speed Speed in range of [0,max_speed]
+  * @return Throttle position estimate from speed (linear relationship) [0,1]
+  */
+  Scalar speedToThrottle(const ParamsSnapshot& params, Scalar speed) const;
 
   /**
   * @brief Calculate the direction to minimize turning angle (eg, don't turn
@@ -79,16 +142,26 @@ class Limits {
   * @param desired_heading Desired heading in radians
   * @return Angle and direction (+/-) to turn (rad)
   */
-  double shortestArcToTurn(double current_heading, double desired_heading)
-  const;
+  Scalar shortestArcToTurn(Scalar current_heading, Scalar desired_heading)
+  const {
+    constexpr Scalar pi = static_cast<Scalar>(M_PI);
+    Scalar heading_command = (desired_heading - current_heading);
+    if (heading_command > pi)
+      heading_command -= 2*pi;
+    if (heading_command < -pi)
+      heading_command += 2*pi;
+    return heading_command;
+  }
 
   /**
   * @brief Bound heading to [-pi,pi) range; prevents odd behavior.
-  * @param current_heading Current heading in radians
-  * @param desired_heading Desired heading in radians
-  * @return Bound heading in radians
+  * This executes in constant time, in the Scalar type; see wrapAngle().
+  * @param heading Heading in radians
+  * @return Bound heading in radians (NaN for non-finite headings)
   */
-  double boundHeading(const double heading) const;
+  Scalar boundHeading(const Scalar heading) const {
+    return wrapAngle(heading);
+  }
 
  private:
   /**
@@ -97,4 +170,137 @@ class Limits {
   const std::shared_ptr<const Params> params_;
 };
 
+/**
+* @brief The default (double precision, fully constrained) limits.
+ */
+using Limits = BasicLimits<double>;
+
+template <typename Scalar, typename Constraints>
+inline Scalar BasicLimits<Scalar, Constraints>::throttleToSpeed(
+    const ParamsSnapshot& params, Scalar throttle) const {
+  Scalar speed_calc;
+  if (throttle > static_cast<Scalar>(params.throttle_max))
+    throttle = params.throttle_max;
+  if (throttle < static_cast<Scalar>(params.throttle_min))
+    throttle = params.throttle_min;
+
+  if (throttle <= 0)
+    speed_calc = 0;
+  else
+    speed_calc = throttle * static_cast<Scalar>(params.velocity_max);
+
+  return speed_calc;
+}
+
+template <typename Scalar, typename Constraints>
+inline Scalar BasicLimits<Scalar, Constraints>::speedToThrottle(
+    const ParamsSnapshot& params, Scalar speed) const {
+  Scalar throttle_calc;
+
+  if (speed > static_cast<Scalar>(params.velocity_max))
+    speed = params.velocity_max;
+  if (speed < static_cast<Scalar>(params.velocity_min))
+    speed = params.velocity_min;
+
+  if (speed <= 0)
+    throttle_calc = 0;
+  else
+    throttle_calc = speed / static_cast<Scalar>(params.velocity_max);
+  return throttle_calc;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicLimits<Scalar, Constraints>::limit(
+    const ParamsSnapshot& params,
+    const Scalar current_speed,
+    const Scalar current_steering,
+    const Scalar current_steering_vel,
+    Scalar& desired_throttle,
+    Scalar& desired_steering,
+    Scalar& desired_steering_vel,
+    Scalar dt) const {
+    // BEGIN THROTTLE LIMITATION SECTION
+    // limit current_throttle to [min,max]
+    if (desired_throttle > static_cast<Scalar>(params.throttle_max))
+      desired_throttle = params.throttle_max;
+    if (desired_throttle < static_cast<Scalar>(params.throttle_min))
+      desired_throttle = params.throttle_min;
+
+    // scale throttle to velocity commanded
+    Scalar new_velocity = throttleToSpeed(params, desired_throttle);
+    if (new_velocity > static_cast<Scalar>(params.velocity_max)) {
+      new_velocity = params.velocity_max;
+      desired_throttle = speedToThrottle(params, new_velocity);
+    }
+    if (new_velocity < static_cast<Scalar>(params.velocity_min)) {
+      new_velocity = params.velocity_min;
+      desired_throttle = speedToThrottle(params, new_velocity);
+    }
+
+    if (Constraints::rates) {
+      // scale previous throttle to velocity & calculate commanded
+      // acceleration
+      Scalar desired_acceleration = (new_velocity - current_speed) / dt;
+      // limit acceleration
+      if (desired_acceleration
+          > static_cast<Scalar>(params.acceleration_max)) {
+        desired_acceleration = params.acceleration_max;
+        new_velocity = current_speed + desired_acceleration * dt;
+        desired_throttle = speedToThrottle(params, new_velocity);
+      }
+      if (desired_acceleration
+          < static_cast<Scalar>(params.acceleration_min)) {
+        desired_acceleration = params.acceleration_min;
+        new_velocity = current_speed + desired_acceleration * dt;
+        desired_throttle = speedToThrottle(params, new_velocity);
+      }
+    }
+    // END THROTTLE LIMITATION SECTION
+
+    // BEGIN STEERING LIMITATION SECTION
+    // limit heading my max angle
+    const Scalar max_steering = params.max_steering_angle;
+    if (desired_steering > max_steering) {
+      desired_steering = max_steering;
+    }
+    if (desired_steering < -max_steering) {
+      desired_steering = -max_steering;
+    }
+
+    // limit heading by max angle rate of change (angular velocity)
+    desired_steering_vel = (desired_steering - current_steering) / dt;
+    if (!Constraints::rates)
+      return;
+    if (desired_steering_vel
+        > static_cast<Scalar>(params.angular_velocity_max)) {
+      desired_steering_vel = params.angular_velocity_max;
+      desired_steering = current_steering + desired_steering_vel*dt;
+    }
+    if (desired_steering_vel
+        < static_cast<Scalar>(params.angular_velocity_min)) {
+      desired_steering_vel = params.angular_velocity_min;
+      desired_steering = current_steering + desired_steering_vel*dt;
+    }
+
+    // limit heading by max angle rate of change rate of change (angular accel)
+    Scalar steering_accel = (desired_steering_vel - current_steering_vel) / dt;
+    if (steering_accel > static_cast<Scalar>(params.angular_acceleration_max)) {
+      steering_accel = params.angular_acceleration_max;
+      desired_steering_vel = current_steering_vel + steering_accel*dt;
+      desired_steering = current_steering
+                         + (current_steering_vel*dt)
+                         + Scalar(.5)*steering_accel*dt*dt;
+    }
+    if (steering_accel < static_cast<Scalar>(params.angular_acceleration_min)) {
+      steering_accel = params.angular_acceleration_min;
+      desired_steering_vel = current_steering_vel + steering_accel*dt;
+      desired_steering = current_steering
+                         + (current_steering_vel*dt)
+                         + Scalar(.5)*steering_accel*dt*dt;
+    }
+}
+
+extern template class BasicLimits<double>;
+extern template class BasicLimits<float>;
+
 }  // namespace ackermann
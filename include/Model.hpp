@@ -9,25 +9,51 @@
  * @copyright [2020]
  */
 
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
 #include <memory>
 #include <atomic>
 
+#include "Angle.hpp"
 #include "Params.hpp"
 #include "Limits.hpp"
+#include "Samples.hpp"
+#include "SeqLock.hpp"
+#include "Kinematics.hpp"
 
 
 namespace ackermann {
 
 /**
 * @brief This class is used to further define a vehicle with Ackermann steering
+ *
+ * State and commands are held and simulated in the given Scalar type, and
+ * limited according to the given constraint policy (see Limits.hpp). The
+ * implementation is defined here (for inlining); Model is the default
+ * instantiation.
+ *
+ * The state and setpoint are each written by one thread (e.g. a sensor and
+ * a client), while command() is called by another (the control thread),
+ * which owns the integrated state. Each input is published through its own
+ * single writer SeqLock and consumed by sync(), which never waits on the
+ * inputs' writers; the state and setpoint in effect are published through
+ * separate single writer SeqLocks for any other thread to read.
  */
-class Model {
+template <typename Scalar, typename Constraints = KinematicConstraints>
+class BasicModel {
  public:
+  using StateSample = BasicStateSample<Scalar>;
+  using GoalSample = BasicGoalSample<Scalar>;
+
   /**
   * @brief Constructor
   * @param params Shared pointer detailing rover characteristic parameters
   */
-  explicit Model(const std::shared_ptr<const Params>& params);
+  explicit BasicModel(const std::shared_ptr<const Params>& params)
+    : params_(params), limits_(params) {
+    this->reset();
+  }
 
   /**
   * @brief Reset system state variables to defaults.
@@ -39,8 +65,21 @@ class Model {
    *
    * @param speed: Actual system speed (m/s)
    * @param heading: Actual system heading (rad).
+   * @return False if the state was rejected; see setState(StateSample).
    */
-  void setState(const double speed, const double heading);
+  bool setState(const Scalar speed, const Scalar heading);
+
+  /**
+  * @brief Set the current system state (published atomically).
+   *
+   * This may be called by one thread at a time; the state takes effect
+   * when the thread calling command() next consumes it (see sync()).
+   *
+   * @param state: Actual system state and its measurement time.
+   * @return False (and the state is left unchanged) if the speed or
+   * heading is not finite.
+   */
+  bool setState(const StateSample& state);
 
   /**
   * @brief Get the current state estimate; return
@@ -49,15 +88,39 @@ class Model {
    * @param speed: Estimated system speed (m/s).
    * @param heading: Estimated system heading (rad).
    */
-  void getState(double& speed, double& heading) const;
+  void getState(Scalar& speed, Scalar& heading) const;
+
+  /**
+  * @brief Get a consistent copy of the current state estimate.
+   *
+   * The timestamp is that of the latest measurement the estimate is based on.
+   * This is the latest measurement if it hasn't been consumed yet (or is
+   * being written), and the integrated state otherwise.
+   *
+   * @param state: Estimated system state.
+   */
+  void getState(StateSample& state) const;
 
   /**
   * @brief Set the target setpoint.
    *
    * @param speed: Desired system speed (m/s).
    * @param heading: Desired system heading (rad).
+   * @return False if the setpoint was rejected; see setGoal(GoalSample).
    */
-  void setGoal(const double speed, const double heading);
+  bool setGoal(const Scalar speed, const Scalar heading);
+
+  /**
+  * @brief Set the target setpoint (published atomically).
+   *
+   * This may be called by one thread at a time; the setpoint takes effect
+   * when the thread calling command() next consumes it (see sync()).
+   *
+   * @param goal: Desired system state and the time it was issued.
+   * @return False (and the setpoint is left unchanged) if the speed or
+   * heading is not finite.
+   */
+  bool setGoal(const GoalSample& goal);
 
   /**
   * @brief Get the current setpoint; return
@@ -66,7 +129,57 @@ class Model {
    * @param speed: Desired system speed (m/s).
    * @param heading: Desired system heading (rad).
    */
-  void getGoal(double& speed, double& heading) const;
+  void getGoal(Scalar& speed, Scalar& heading) const;
+
+  /**
+  * @brief Get a consistent copy of the current setpoint.
+   *
+   * @param goal: Desired system state.
+   */
+  void getGoal(GoalSample& goal) const;
+
+  /**
+  * @brief Consume any new state and setpoint published by setState() and
+  * setGoal(); executed on the thread which calls command().
+   *
+   * This never waits on the inputs' writers: an input whose writer is
+   * mid-update is consumed by a later call instead.
+   */
+  void sync();
+
+  /**
+  * @brief Replace the current state, bypassing setState() (e.g. with a
+  * prediction); executed on the thread which calls command().
+   *
+   * @param state: The new system state.
+   * @return False (and the state is left unchanged) if the speed or
+   * heading is not finite.
+   */
+  bool adoptState(const StateSample& state);
+
+  /**
+  * @brief Replace the current setpoint, bypassing setGoal() (e.g. with a
+  * trajectory's); executed on the thread which calls command().
+   *
+   * The setpoint remains in effect until the next one is adopted, or a
+   * newer one is published by setGoal() and consumed.
+   *
+   * @param goal: The new setpoint.
+   * @return False (and the setpoint is left unchanged) if the speed or
+   * heading is not finite.
+   */
+  bool adoptGoal(const GoalSample& goal);
+
+  /**
+  * @brief Get the state and setpoint in effect, as consumed by sync() or
+  * adopted since; only valid on the thread which calls command().
+   *
+   * Unlike getState() and getGoal(), this reads no shared data.
+   *
+   * @param state: The current system state.
+   * @param goal: The current setpoint.
+   */
+  void getInputs(StateSample& state, GoalSample& goal) const;
 
   /**
   * @brief Get the current commanded throttle and steering angle; return
@@ -75,7 +188,7 @@ class Model {
    * @param throttle: The last commanded throttle (limited to [0,1]).
    * @param steering: The last commanded steering angle (rad).
    */
-  void getCommand(double& throttle, double& steering) const;
+  void getCommand(Scalar& throttle, Scalar& steering) const;
 
   /**
   * @brief Get the current commanded throttle and steering angle; return
@@ -85,7 +198,7 @@ class Model {
    * @param steering: The last commanded steering angle (rad).
    * @param steer_vel: The current steering angle velocity (rad/s).
    */
-  void getCommand(double& throttle, double& steering, double& steer_vel) const;
+  void getCommand(Scalar& throttle, Scalar& steering, Scalar& steer_vel) const;
 
   /**
   * @brief Simulate execution of the given throttle and steering commands.
@@ -94,7 +207,23 @@ class Model {
    * @param steering: The commanded steering angle (rad).
    * @param dt: The amount of time to simulate over (s).
    */
-  void command(double desired_speed, double steering, const double dt);
+  void command(Scalar throttle, Scalar steering, const Scalar dt);
+
+  /**
+  * @brief Simulate execution of the given throttle and steering commands,
+  * using the given parameter snapshot.
+   *
+   * Any new inputs are consumed first (see sync()).
+   *
+   * @param params: Consistent set of parameters to simulate with.
+   * @param throttle: The commanded throttle ([0,1]).
+   * @param steering: The commanded steering angle (rad).
+   * @param dt: The amount of time to simulate over (s).
+   */
+  void command(const ParamsSnapshot& params,
+               Scalar throttle,
+               Scalar steering,
+               const Scalar dt);
 
   /**
   * @brief Return the current error between desired and setpoint; return
@@ -103,24 +232,77 @@ class Model {
    * @param speed_error: Current speed error (m/s).
    * @param heading_error: Current heading error (rad).
    */
-  void getError(double& speed_error, double& heading_error) const;
+  void getError(Scalar& speed_error, Scalar& heading_error) const;
 
   /**
   * @brief Return the current linear velocity at each wheel; used for
   * calculating wheel speed with tire information. Return
   * as parameters specified.
+   *
+   * This uses the wheel geometry cached by the latest command(), so it
+   * costs four multiplies (and none while driving straight).
    *
    * @param wheel_LeftFront&: Left front wheel linear velocity
    * @param wheel_RightFront&: Right front wheel linear velocity
    * @param wheel_LeftRear&: Left rear wheel linear velocity
    * @param wheel_RightRear&: Right rear wheel linear velocity
    */
-  void getWheelLinVel(double& wheel_LeftFront,
-                      double& wheel_RightFront,
-                      double& wheel_LeftRear,
-                      double& wheel_RightRear) const;
+  void getWheelLinVel(Scalar& wheel_LeftFront,
+                      Scalar& wheel_RightFront,
+                      Scalar& wheel_LeftRear,
+                      Scalar& wheel_RightRear) const;
 
  private:
+  // fields are grouped by the thread which writes them, each group starting
+  // on its own cache line, so that (e.g.) a sensor thread publishing states
+  // doesn't invalidate the control thread's commands; instances must be
+  // allocated with -faligned-new (or on the stack) to honor this
+  static constexpr std::size_t kCacheLine = 64;
+
+  /**
+  * @brief Reads of an input attempted before leaving it for later.
+  */
+  static constexpr unsigned kReadAttempts = 16;
+
+  /**
+  * @brief A value owned by the control thread, and the version of the
+  * input it was last consumed from.
+  */
+  template <typename Sample>
+  struct Owned {
+    Sample value;
+    uint64_t input;
+  };
+
+  /**
+  * @brief Bound the heading of the given state or setpoint.
+   * @return False if the speed or heading is not finite.
+   */
+  template <typename Sample>
+  bool bound(Sample& sample) const;
+
+  /**
+  * @brief Consume the given input into its owned value, unless it's
+  * unchanged (or being written).
+   * @return True if the owned value changed.
+   */
+  template <typename Sample>
+  static bool consume(const SeqLock<Sample, true>& input,
+                      Owned<Sample>& owned);
+
+  /**
+  * @brief Return the given published value, or its input if newer; never
+  * waits on the input's writer.
+  */
+  template <typename Sample>
+  static Sample latest(const SeqLock<Owned<Sample>, true>& published,
+                       const SeqLock<Sample, true>& input);
+
+  /**
+  * @brief Publish the current state (executed on the commanding thread).
+  */
+  void publishState();
+
    /**
    * @brief shared parameter object (contains system kinematics)
     */
@@ -128,41 +310,300 @@ class Model {
   /**
   * @brief Limits object contains limitations imposed on model behavior
    */
-  std::unique_ptr<Limits> limits_;
+  BasicLimits<Scalar, Constraints> limits_;
 
-  // system state variables
+  // system state variables (written by the control thread)
   // use for current conditions for limits
   /**
   * @brief Current throttle setting for rover.
   */
-  std::atomic<double> current_throttle_ {0.0};
+  alignas(kCacheLine) std::atomic<Scalar> current_throttle_ {0};
   /**
   * @brief Current steering position for rover.
   */
-  std::atomic<double> current_steering_ {0.0};
+  std::atomic<Scalar> current_steering_ {0};
   /**
   * @brief Current steering velocity for rover.
   */
-  std::atomic<double> current_steering_vel_ {0.0};
+  std::atomic<Scalar> current_steering_vel_ {0};
+  /**
+  * @brief Current speed for rover (that of state_, for wheel speeds).
+  */
+  std::atomic<Scalar> current_speed_ {0};
 
-  // use for setting goal
   /**
-  * @brief Desired speed for rover.
+  * @brief Wheel geometry of the current steering angle (and parameters).
   */
-  std::atomic<double> desired_speed_ {0.0};
+  SeqLock<BasicWheelFactors<Scalar>, true> wheel_factors_;
+
   /**
-  * @brief Desired heading for rover.
+  * @brief Current speed and heading (integrated by command()) and
+  * setpoint, and their published copies.
   */
-  std::atomic<double> desired_heading_ {0.0};
+  Owned<StateSample> state_;
+  Owned<GoalSample> goal_;
+  SeqLock<Owned<StateSample>, true> published_state_;
+  SeqLock<Owned<GoalSample>, true> published_goal_;
 
-  // current states
+  // use for setting goal (written by a client)
   /**
-  * @brief Current speed for rover.
+  * @brief Desired speed and heading for rover.
   */
-  std::atomic<double> current_speed_ {0.0};
+  alignas(kCacheLine) SeqLock<GoalSample, true> goal_input_;
+
+  // measured states (written by the sensor thread)
   /**
-  * @brief Current heading for rover.
+  * @brief Measured speed and heading for rover.
   */
-  std::atomic<double> current_heading_ {0.0};
+  alignas(kCacheLine) SeqLock<StateSample, true> state_input_;
 };
+
+/**
+* @brief The default (double precision, fully constrained) model.
+ */
+using Model = BasicModel<double>;
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::reset() {
+  this->goal_input_.store(GoalSample());
+  this->state_input_.store(StateSample());
+  this->goal_ = {GoalSample(), this->goal_input_.version()};
+  this->state_ = {StateSample(), this->state_input_.version()};
+  this->published_goal_.store(this->goal_);
+  this->publishState();
+  this->current_throttle_ = 0;
+  this->current_steering_ = 0;
+  this->wheel_factors_.store(BasicWheelFactors<Scalar>());
+}
+
+template <typename Scalar, typename Constraints>
+inline bool BasicModel<Scalar, Constraints>::setState(const Scalar speed,
+                                                      const Scalar heading) {
+  return this->setState({speed, heading, Clock::now()});
+}
+
+template <typename Scalar, typename Constraints>
+inline bool BasicModel<Scalar, Constraints>::setState(
+    const StateSample& state) {
+  StateSample bounded = state;
+  if (!this->bound(bounded))
+    return false;
+  this->state_input_.store(bounded);
+  return true;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::getState(Scalar& speed,
+                                                      Scalar& heading) const {
+  const StateSample state = latest(this->published_state_,
+                                   this->state_input_);
+  speed = state.speed;
+  heading = state.heading;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::getState(
+    StateSample& state) const {
+  state = latest(this->published_state_, this->state_input_);
+}
+
+template <typename Scalar, typename Constraints>
+inline bool BasicModel<Scalar, Constraints>::setGoal(const Scalar speed,
+                                                     const Scalar heading) {
+  return this->setGoal({speed, heading, Clock::now()});
+}
+
+template <typename Scalar, typename Constraints>
+inline bool BasicModel<Scalar, Constraints>::setGoal(const GoalSample& goal) {
+  GoalSample bounded = goal;
+  if (!this->bound(bounded))
+    return false;
+  this->goal_input_.store(bounded);
+  return true;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::getGoal(Scalar& speed,
+                                                     Scalar& heading) const {
+  const GoalSample goal = latest(this->published_goal_, this->goal_input_);
+  speed = goal.speed;
+  heading = goal.heading;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::getGoal(GoalSample& goal) const {
+  goal = latest(this->published_goal_, this->goal_input_);
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::sync() {
+  if (consume(this->state_input_, this->state_))
+    this->publishState();
+  if (consume(this->goal_input_, this->goal_))
+    this->published_goal_.store(this->goal_);
+}
+
+template <typename Scalar, typename Constraints>
+inline bool BasicModel<Scalar, Constraints>::adoptState(
+    const StateSample& state) {
+  StateSample bounded = state;
+  if (!this->bound(bounded))
+    return false;
+  this->state_.value = bounded;
+  this->publishState();
+  return true;
+}
+
+template <typename Scalar, typename Constraints>
+inline bool BasicModel<Scalar, Constraints>::adoptGoal(
+    const GoalSample& goal) {
+  GoalSample bounded = goal;
+  if (!this->bound(bounded))
+    return false;
+  this->goal_.value = bounded;
+  this->published_goal_.store(this->goal_);
+  return true;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::getInputs(
+    StateSample& state, GoalSample& goal) const {
+  state = this->state_.value;
+  goal = this->goal_.value;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::getCommand(
+    Scalar& throttle, Scalar& steering) const {
+  throttle = this->current_throttle_;
+  steering = this->current_steering_;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::getCommand(
+    Scalar& throttle, Scalar& steering, Scalar& steer_vel) const {
+  throttle = this->current_throttle_;
+  steering = this->current_steering_;
+  steer_vel = this->current_steering_vel_;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::command(
+    const Scalar cmd_throttle, const Scalar steering, const Scalar dt) {
+  this->command(params_->snapshot(), cmd_throttle, steering, dt);
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::command(
+    const ParamsSnapshot& params,
+    const Scalar cmd_throttle,
+    const Scalar steering,
+    const Scalar dt) {
+  // update current throttle to new value
+  this->current_throttle_ = cmd_throttle;
+  // update current steering value to output from limit
+  this->current_steering_vel_ = (steering - this->current_steering_) / dt;
+  this->current_steering_ = steering;
+  // take throttle and convert to speed, then update current heading to new
+  // heading value, starting from the latest measurement; this is a single
+  // atomic update of the published state (the timestamp of the underlying
+  // measurement is retained)
+  this->sync();
+  const Scalar wheel_base = params.wheel_base;
+  const Scalar speed = limits_.throttleToSpeed(params, cmd_throttle);
+  const Scalar tan_steering = std::tan(steering);
+  const Scalar heading_rate = (speed/wheel_base) * tan_steering;
+  StateSample& state = this->state_.value;
+  state.speed = speed;
+  state.heading = limits_.boundHeading(state.heading + heading_rate * dt);
+  this->publishState();
+  // cache the wheel geometry of this steering angle
+  this->wheel_factors_.store(
+    wheelFactors(tan_steering, wheel_base,
+                 static_cast<Scalar>(params.track_width)));
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::getError(
+    Scalar& speed_error, Scalar& heading_error) const {
+  StateSample state;
+  this->getState(state);
+  GoalSample goal;
+  this->getGoal(goal);
+  speed_error = goal.speed - state.speed;
+  // minimize heading error
+  heading_error = limits_.shortestArcToTurn(state.heading, goal.heading);
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::getWheelLinVel(
+    Scalar& wheel_LeftFront,
+    Scalar& wheel_RightFront,
+    Scalar& wheel_LeftRear,
+    Scalar& wheel_RightRear) const {
+  const Scalar current_speed =
+    this->current_speed_.load(std::memory_order_relaxed);
+  // if driving straight all wheel speeds equal current speed; this needs no
+  // snapshot of the wheel geometry
+  if (this->current_steering_.load(std::memory_order_relaxed) == 0) {
+    wheel_LeftFront = wheel_RightFront = current_speed;
+    wheel_LeftRear = wheel_RightRear = current_speed;
+    return;
+  }
+  const BasicWheelFactors<Scalar> f = this->wheel_factors_.load();
+  // while turning, absolute value because wheels still move forward (the
+  // geometry may be that of a newer, straight, command)
+  const Scalar speed = f.tan_steering != 0 ? std::abs(current_speed)
+                                           : current_speed;
+  wheel_LeftFront = speed * f.left_front;
+  wheel_RightFront = speed * f.right_front;
+  wheel_LeftRear = speed * f.left_rear;
+  wheel_RightRear = speed * f.right_rear;
+}
+
+template <typename Scalar, typename Constraints>
+inline void BasicModel<Scalar, Constraints>::publishState() {
+  this->published_state_.store(this->state_);
+  this->current_speed_.store(this->state_.value.speed,
+                             std::memory_order_relaxed);
+}
+
+template <typename Scalar, typename Constraints>
+template <typename Sample>
+inline bool BasicModel<Scalar, Constraints>::bound(Sample& sample) const {
+  sample.heading = limits_.boundHeading(sample.heading);
+  // reject corrupt inputs (wrapAngle maps non-finite values to NaN)
+  return std::isfinite(sample.speed) && !std::isnan(sample.heading);
+}
+
+template <typename Scalar, typename Constraints>
+template <typename Sample>
+inline bool BasicModel<Scalar, Constraints>::consume(
+    const SeqLock<Sample, true>& input, Owned<Sample>& owned) {
+  Sample value;
+  uint64_t version;
+  if (input.version() == owned.input
+      || !input.tryLoad(value, version, kReadAttempts)
+      || version == owned.input)
+    return false;
+  owned = {value, version};
+  return true;
+}
+
+template <typename Scalar, typename Constraints>
+template <typename Sample>
+inline Sample BasicModel<Scalar, Constraints>::latest(
+    const SeqLock<Owned<Sample>, true>& published,
+    const SeqLock<Sample, true>& input) {
+  const Owned<Sample> owned = published.load();
+  Sample value = owned.value;
+  // (should the input's writer be mid-update, the published value stands)
+  if (input.version() != owned.input)
+    input.tryLoad(value, kReadAttempts);
+  return value;
+}
+
+extern template class BasicModel<double>;
+extern template class BasicModel<float>;
+
 }  // namespace ackermann
@@ -0,0 +1,76 @@
+#pragma once
+
+/**
+ * @file Notifier.hpp
+ * @brief A futex based event used to wake threads waiting for new data.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <atomic>
+#include <cstdint>
+
+#include "Samples.hpp"
+
+namespace ackermann {
+
+/**
+* @brief An event counter that threads can block on until it changes.
+ *
+ * The notifying side never blocks, and only enters the kernel if a thread
+ * is actually waiting. Waiters read value(), check whatever data they are
+ * interested in, and then wait() for the value to change; since the value
+ * is read first, a notification between the check and the wait is never
+ * lost.
+ */
+class Notifier {
+ public:
+  /**
+  * @brief Constructor.
+   *
+   * @param shared: Whether the notifier may be used by several processes
+   * (i.e. lives in shared memory); this is slightly more expensive.
+   */
+  explicit Notifier(const bool shared = false) : shared_(shared) {}
+
+  /**
+  * @brief Return the current event count (to pass to wait()).
+  */
+  uint32_t value() const;
+
+  /**
+  * @brief Increment the event count, waking all waiting threads.
+  */
+  void notify();
+
+  /**
+  * @brief Block until the event count differs from the given value.
+   *
+   * @param last: The value previously returned by value().
+   * @param deadline: Give up at this time; Clock::time_point::max() waits
+   * indefinitely.
+   * @return False if the deadline passed without a notification.
+   */
+  bool wait(const uint32_t last, const Clock::time_point deadline) const;
+
+ private:
+  /**
+  * @brief The event count (this is the futex word).
+  */
+  mutable std::atomic<uint32_t> value_ {0};
+
+  /**
+  * @brief Number of threads currently in wait().
+  */
+  mutable std::atomic<uint32_t> waiters_ {0};
+
+  /**
+  * @brief Whether waiters may be in other processes.
+  */
+  const bool shared_;
+};
+
+}  // namespace ackermann
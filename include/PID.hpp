@@ -16,12 +16,93 @@
 
 namespace ackermann {
 
+/**
+* @brief The individual contributions to the latest PID output.
+*/
+template <typename Scalar>
+struct BasicPIDTerms {
+  /**
+  * @brief Proportional term.
+  */
+  Scalar p {0};
+  /**
+  * @brief Integral term.
+  */
+  Scalar i {0};
+  /**
+  * @brief Derivative term.
+  */
+  Scalar d {0};
+};
+
+using PIDTerms = BasicPIDTerms<double>;
+
+/**
+* @brief Anti windup policy: on saturation, remove the excess output from
+* the integral error (back calculation).
+*/
+struct BackCalculation {
+  template <typename Scalar>
+  static Scalar saturate(Scalar output, Scalar& integral_error, Scalar,
+                         Scalar, Scalar min, Scalar max) {
+    if (output > max) {
+      integral_error -= output - max;
+      output = max;
+    } else if (output < min) {
+      integral_error += min - output;
+      output = min;
+    }
+    return output;
+  }
+};
+
+/**
+* @brief Anti windup policy: on saturation, stop integrating errors which
+* would drive the output further into saturation.
+*/
+struct ConditionalIntegration {
+  template <typename Scalar>
+  static Scalar saturate(Scalar output, Scalar& integral_error, Scalar error,
+                         Scalar dt, Scalar min, Scalar max) {
+    if (output > max) {
+      if (error > 0)
+        integral_error -= error * dt;
+      output = max;
+    } else if (output < min) {
+      if (error < 0)
+        integral_error -= error * dt;
+      output = min;
+    }
+    return output;
+  }
+};
+
+/**
+* @brief Anti windup policy: none; the output is clamped, but the integral
+* error is left to grow.
+*/
+struct NoAntiWindup {
+  template <typename Scalar>
+  static Scalar saturate(Scalar output, Scalar&, Scalar, Scalar,
+                         Scalar min, Scalar max) {
+    return output > max ? max : output < min ? min : output;
+  }
+};
+
 /**
 * @brief This class implements a PID controller with max/min clamping of output
 * values to prevent integral windup.
-*/
-class PID {
+ *
+ * The arithmetic is performed in the given Scalar type (e.g. float on cores
+ * without fast double precision), and saturation is handled by the given
+ * anti windup policy. Everything is defined here so that a control loop can
+ * inline it; PID is the default (double precision) instantiation.
+ */
+template <typename Scalar, typename AntiWindup = BackCalculation>
+class BasicPID {
  public:
+  using Terms = BasicPIDTerms<Scalar>;
+
   /**
   * @brief Constructor
    * @param params Shared PIDParams pointer detailing PID parameters
@@ -31,44 +112,75 @@ class PID {
    * @param out_maxLimit Optional, clamp maximum value of PID controller
    * output
    */
-  explicit PID(const std::shared_ptr<const PIDParams>& params,
-               double out_minLimit = std::numeric_limits<double>::lowest(),
-               double out_maxLimit = std::numeric_limits<double>::max());
+  explicit BasicPID(const std::shared_ptr<const PIDParams>& params,
+                    Scalar out_minLimit = std::numeric_limits<Scalar>::lowest(),
+                    Scalar out_maxLimit = std::numeric_limits<Scalar>::max())
+    : params_{params},
+      out_minLimit_{out_minLimit},
+      out_maxLimit_{out_maxLimit} {
+  }
 
   /**
   * @brief Get the kP Proportional Gain
    * @param None
    * @return Proportional Gain
    */
-  double get_k_p() const;
+  double get_k_p() const {return this->params_->kp;}
 
   /**
   * @brief Get the kI Integral Gain
    * @param None
    * @return Proportional Gain
    */
-  double get_k_i() const;
+  double get_k_i() const {return this->params_->ki;}
 
   /**
   *  @brief Get the kD Derivative Gain
    * @param None
    * @return Derivative Gain
    */
-  double get_k_d() const;
+  double get_k_d() const {return this->params_->kd;}
 
   /** @brief Perform PID Calculation
    * @param current_error Current Error (Feedback)
    * @param dt Change in time since previous value collected.
    * @return Output
    */
-  double getCommand(double current_error, double dt);
+  Scalar getCommand(Scalar current_error, Scalar dt) {
+    PIDGains gains;
+    gains.kp = params_->kp;
+    gains.ki = params_->ki;
+    gains.kd = params_->kd;
+    return getCommand(current_error, dt, gains);
+  }
+
+  /** @brief Perform PID Calculation with the given (snapshot) gains
+   * @param current_error Current Error (Feedback)
+   * @param dt Change in time since previous value collected.
+   * @param gains PID gains to use instead of our shared parameters.
+   * @return Output
+   */
+  Scalar getCommand(Scalar current_error, Scalar dt, const PIDGains& gains);
+
+  /**
+  * @brief Get the terms of the latest calculation (before windup clamping)
+   * @param None
+   * @return Proportional, integral and derivative terms
+   */
+  Terms getTerms() const {
+    return this->terms_;
+  }
 
   /**
   * @brief Reset the PID
    * @param None
    * @return None
    */
-  void reset_PID();
+  void reset_PID() {
+    this->prev_error_ = 0;
+    this->integral_error_ = 0;
+    this->terms_ = Terms();
+  }
 
  private:
   /**
@@ -79,22 +191,56 @@ class PID {
   /**
   * @brief Previous Error
   */
-  double prev_error_;
+  Scalar prev_error_ {0};
 
   /**
   * @brief Integral Error
   */
-  double integral_error_;
+  Scalar integral_error_ {0};
 
   /**
   * @brief Output Minimum Limit (For PID windup)
   */
-  double out_minLimit_;
+  Scalar out_minLimit_;
 
   /**
   * @brief Output Maximum Limit (For PID windup)
   */
-  double out_maxLimit_;
+  Scalar out_maxLimit_;
+
+  /**
+  * @brief Terms of the latest calculation
+  */
+  Terms terms_;
 };
 
+/**
+* @brief The default (double precision, back calculating) PID controller.
+*/
+using PID = BasicPID<double>;
+
+template <typename Scalar, typename AntiWindup>
+inline Scalar BasicPID<Scalar, AntiWindup>::getCommand(
+    Scalar current_error, Scalar dt, const PIDGains& gains) {
+  // Integral controller portion
+  integral_error_ += (current_error * dt);
+  // Derivative
+  Scalar derivative = (current_error - prev_error_) / dt;
+  // calculate output
+  terms_.p = static_cast<Scalar>(gains.kp)*current_error;
+  terms_.i = static_cast<Scalar>(gains.ki)*integral_error_;
+  terms_.d = static_cast<Scalar>(gains.kd)*derivative;
+  Scalar output = terms_.p + terms_.i + terms_.d;
+  // PID windup
+  output = AntiWindup::saturate(output, integral_error_, current_error, dt,
+                                out_minLimit_, out_maxLimit_);
+  // save error as previous prev_error_
+  prev_error_ = current_error;
+  // return output;
+  return output;
+}
+
+extern template class BasicPID<double>;
+extern template class BasicPID<float>;
+
 }  // namespace ackermann
@@ -12,6 +12,10 @@
 #include <memory>
 #include <atomic>
 #include <limits>
+#include <mutex>
+#include <cstdint>
+
+#include "SeqLock.hpp"
 
 namespace ackermann {
 
@@ -44,8 +48,77 @@ struct PIDParams {
   {};
 };
 
+/**
+* @brief Plain (non atomic) copy of a set of PID gains.
+ */
+struct PIDGains {
+  /**
+  * @brief Proportinal gain.
+  */
+  double kp {0.0};
+  /**
+  * @brief Integral gain.
+  */
+  double ki {0.0};
+  /**
+  * @brief Derivative gain.
+  */
+  double kd {0.0};
+};
+
+/**
+* @brief Immutable, consistent copy of every value in Params.
+ *
+ * The control loop takes one of these per iteration (see
+ * Params::snapshot()) and reads plain doubles from it, instead of loading
+ * each atomic parameter individually.
+ */
+struct ParamsSnapshot {
+  /**
+  * @brief Number of Params::update() calls published before this copy.
+  */
+  uint64_t version {0};
+  /** @brief Desired frequency of controller loop (hz). */
+  double control_frequency {0.0};
+  /** @brief Maximum allowable velocity of rover (m/s). */
+  double velocity_max {0.0};
+  /** @brief Minimum allowable velocity of rover (m/s). */
+  double velocity_min {0.0};
+  /** @brief Maximum allowable acceleration (m/s^2). */
+  double acceleration_max {0.0};
+  /** @brief Minimum allowable acceleration (m/s^2). */
+  double acceleration_min {0.0};
+  /** @brief Maximum steering velocity (rad/s). */
+  double angular_velocity_max {0.0};
+  /** @brief Minimum steering velocity (rad/s). */
+  double angular_velocity_min {0.0};
+  /** @brief Maximum steering acceleration (rad/s^2). */
+  double angular_acceleration_max {0.0};
+  /** @brief Minimum steering acceleration (rad/s^2). */
+  double angular_acceleration_min {0.0};
+  /** @brief Maximum throttle setting. */
+  double throttle_max {0.0};
+  /** @brief Minimum throttle setting. */
+  double throttle_min {0.0};
+  /** @brief Speed controller PID gains. */
+  PIDGains pid_speed;
+  /** @brief Heading controller PID gains. */
+  PIDGains pid_heading;
+  /** @brief Length between front and rear axles (m). */
+  double wheel_base {0.0};
+  /** @brief Width between left and right tires (m). */
+  double track_width {0.0};
+  /** @brief Maximum angle of steering mechanism (rad). */
+  double max_steering_angle {0.0};
+};
+
 /**
 * @brief Structure containing rover characteristics and limitations.
+ *
+ * Individual members may be written directly (each write is atomic), but
+ * changes that must be observed together (e.g. a new set of PID gains)
+ * should be made through update(), which publishes them as a single new
+ * version to snapshot() readers.
  */
 struct Params {
   /**
@@ -139,6 +212,105 @@ struct Params {
       track_width(track_width_),
       max_steering_angle(max_steering_angle_)
   {}
+
+  /* @brief Constructor, using the given (e.g. preallocated) PID parameters */
+  Params(double wheel_base_,
+         double track_width_,
+         double max_steering_angle_,
+         const std::shared_ptr<PIDParams>& pid_speed_,
+         const std::shared_ptr<PIDParams>& pid_heading_)
+    : pid_speed(pid_speed_),
+      pid_heading(pid_heading_),
+      wheel_base(wheel_base_),
+      track_width(track_width_),
+      max_steering_angle(max_steering_angle_)
+  {}
+
+  /**
+  * @brief Atomically modify any number of parameters.
+   *
+   * All changes made by the given function are published as one new
+   * version; snapshot() never returns a partially applied update.
+   *
+   * @param modify Callable invoked as modify(Params&).
+   */
+  template <typename Function>
+  void update(Function&& modify) {
+    std::lock_guard<SequenceLock> guard(lock_);
+    modify(*this);
+  }
+
+  /**
+  * @brief Atomically set every parameter from the given snapshot.
+   *
+   * @param s Values to apply (the version is ignored).
+   */
+  void restore(const ParamsSnapshot& s) {
+    update([&s](Params& p) {
+      p.control_frequency = s.control_frequency;
+      p.velocity_max = s.velocity_max;
+      p.velocity_min = s.velocity_min;
+      p.acceleration_max = s.acceleration_max;
+      p.acceleration_min = s.acceleration_min;
+      p.angular_velocity_max = s.angular_velocity_max;
+      p.angular_velocity_min = s.angular_velocity_min;
+      p.angular_acceleration_max = s.angular_acceleration_max;
+      p.angular_acceleration_min = s.angular_acceleration_min;
+      p.throttle_max = s.throttle_max;
+      p.throttle_min = s.throttle_min;
+      p.pid_speed->kp = s.pid_speed.kp;
+      p.pid_speed->ki = s.pid_speed.ki;
+      p.pid_speed->kd = s.pid_speed.kd;
+      p.pid_heading->kp = s.pid_heading.kp;
+      p.pid_heading->ki = s.pid_heading.ki;
+      p.pid_heading->kd = s.pid_heading.kd;
+      p.wheel_base = s.wheel_base;
+      p.track_width = s.track_width;
+      p.max_steering_angle = s.max_steering_angle;
+    });
+  }
+
+  /**
+  * @brief Return a consistent copy of every parameter.
+   *
+   * This never blocks writers; it retries if an update() overlapped.
+   */
+  ParamsSnapshot snapshot() const {
+    constexpr auto relaxed = std::memory_order_relaxed;
+    ParamsSnapshot s;
+    uint64_t seq;
+    do {
+      seq = lock_.readBegin();
+      s.control_frequency = control_frequency.load(relaxed);
+      s.velocity_max = velocity_max.load(relaxed);
+      s.velocity_min = velocity_min.load(relaxed);
+      s.acceleration_max = acceleration_max.load(relaxed);
+      s.acceleration_min = acceleration_min.load(relaxed);
+      s.angular_velocity_max = angular_velocity_max.load(relaxed);
+      s.angular_velocity_min = angular_velocity_min.load(relaxed);
+      s.angular_acceleration_max = angular_acceleration_max.load(relaxed);
+      s.angular_acceleration_min = angular_acceleration_min.load(relaxed);
+      s.throttle_max = throttle_max.load(relaxed);
+      s.throttle_min = throttle_min.load(relaxed);
+      s.pid_speed.kp = pid_speed->kp.load(relaxed);
+      s.pid_speed.ki = pid_speed->ki.load(relaxed);
+      s.pid_speed.kd = pid_speed->kd.load(relaxed);
+      s.pid_heading.kp = pid_heading->kp.load(relaxed);
+      s.pid_heading.ki = pid_heading->ki.load(relaxed);
+      s.pid_heading.kd = pid_heading->kd.load(relaxed);
+      s.wheel_base = wheel_base.load(relaxed);
+      s.track_width = track_width.load(relaxed);
+      s.max_steering_angle = max_steering_angle.load(relaxed);
+    } while (lock_.readRetry(seq));
+    s.version = seq / 2;
+    return s;
+  }
+
+ private:
+  /**
+  * @brief Sequence lock guarding multi-parameter updates.
+  */
+  SequenceLock lock_;
 };
 
 }  // namespace ackermann
@@ -0,0 +1,117 @@
+#pragma once
+
+/**
+ * @file PlotBuffer.hpp
+ * @brief Bounded, decimated history of a plotted signal.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace ackermann {
+
+/**
+* @brief Fixed size history of (time, value) samples, for plotting.
+ *
+ * This keeps (roughly) the most recent window of samples, using no more
+ * than the given number of points: if the window holds more samples than
+ * that, consecutive samples are combined into buckets represented by their
+ * minimum and maximum (so peaks remain visible). All memory is allocated
+ * on construction.
+ */
+class PlotBuffer {
+ public:
+  /**
+  * @brief Constructor
+   *
+   * @param samples: Number of (most recent) samples to keep.
+   * @param max_points: Maximum number of points to keep them in (>= 2).
+   */
+  PlotBuffer(const std::size_t samples, const std::size_t max_points);
+
+  /**
+  * @brief Append a sample (times must not decrease).
+  */
+  void append(const double time, const double value);
+
+  /**
+  * @brief Remove all samples.
+  */
+  void clear();
+
+  /**
+  * @brief Return the number of points forEach() would visit.
+  */
+  std::size_t size() const;
+
+  /**
+  * @brief Return the number of samples represented by each bucket.
+  */
+  std::size_t decimation() const;
+
+  /**
+  * @brief Visit every point, oldest first.
+   *
+   * @param visit: Callable invoked as visit(time, value).
+   */
+  template <typename Function>
+  void forEach(Function&& visit) const {
+    const std::size_t capacity = times_.size();
+    const std::size_t first = (head_ + capacity - size_) % capacity;
+    for (std::size_t i = 0; i != size_; ++i) {
+      const std::size_t index = (first + i) % capacity;
+      visit(times_[index], values_[index]);
+    }
+    // the (incomplete) latest bucket
+    if (pending_) {
+      const bool min_first = min_time_ <= max_time_;
+      visit(min_first ? min_time_ : max_time_,
+            min_first ? min_value_ : max_value_);
+      if (pending_ > 1)
+        visit(min_first ? max_time_ : min_time_,
+              min_first ? max_value_ : min_value_);
+    }
+  }
+
+  /**
+  * @brief Return the range of values of every point.
+   *
+   * @param min: (Return parameter) Unchanged if less than this.
+   * @param max: (Return parameter) Unchanged if greater than this.
+   */
+  void range(double& min, double& max) const;
+
+ private:
+  /**
+  * @brief Store a completed point.
+  */
+  void push(const double time, const double value);
+
+  /**
+  * @brief Samples per bucket.
+  */
+  const std::size_t decimation_;
+
+  /**
+  * @brief Ring of completed points.
+  */
+  std::vector<double> times_;
+  std::vector<double> values_;
+  std::size_t head_ {0};
+  std::size_t size_ {0};
+
+  /**
+  * @brief The bucket being accumulated: its number of samples, and its
+  * minimum and maximum samples.
+  */
+  std::size_t pending_ {0};
+  double min_time_ {0.0}, min_value_ {0.0};
+  double max_time_ {0.0}, max_value_ {0.0};
+};
+
+}  // namespace ackermann
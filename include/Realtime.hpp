@@ -0,0 +1,100 @@
+#pragma once
+
+/**
+ * @file Realtime.hpp
+ * @brief Real-time execution options (scheduling, CPU affinity and memory
+ * locking) for the control thread.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <cstddef>
+#include <vector>
+
+namespace ackermann {
+
+/**
+* @brief Options controlling how the control thread is executed.
+ *
+ * The defaults leave the thread exactly as created (normal priority, no
+ * pinning, no memory locking).
+ */
+struct RealtimeOptions {
+  /**
+  * @brief Available scheduling policies.
+  */
+  enum class Policy {
+    Default,     ///< Leave the scheduling policy unchanged (SCHED_OTHER).
+    Fifo,        ///< SCHED_FIFO
+    RoundRobin   ///< SCHED_RR
+  };
+
+  /**
+  * @brief Scheduling policy of the control thread.
+  */
+  Policy policy {Policy::Default};
+  /**
+  * @brief Scheduling priority (used for Fifo and RoundRobin only).
+  */
+  int priority {0};
+  /**
+  * @brief CPUs the control thread may execute on; empty for no pinning.
+  */
+  std::vector<int> cpus;
+  /**
+  * @brief Lock all current and future pages of the process into memory.
+  */
+  bool lock_memory {false};
+  /**
+  * @brief Number of bytes of stack to touch before entering the loop;
+  * clamped to the thread's remaining stack, less a safety margin.
+  */
+  std::size_t prefault_stack {0};
+};
+
+/**
+* @brief The result of applying a set of RealtimeOptions.
+ *
+ * Each setting is applied independently; a failure (e.g. due to missing
+ * privileges) leaves the corresponding setting at its default and records
+ * the resulting errno value here.
+ */
+struct RealtimeStatus {
+  /**
+  * @brief Error applying the scheduling policy (0 on success / unused).
+  */
+  int scheduler_error {0};
+  /**
+  * @brief Error applying the CPU affinity (0 on success / unused).
+  */
+  int affinity_error {0};
+  /**
+  * @brief Error locking memory (0 on success / unused).
+  */
+  int lock_memory_error {0};
+  /**
+  * @brief Number of bytes of stack pre-faulted (less than requested if
+  * the request exceeded the stack).
+  */
+  std::size_t stack_prefaulted {0};
+
+  /**
+  * @brief Return true if every requested setting was applied.
+  */
+  bool ok() const {
+    return !scheduler_error && !affinity_error && !lock_memory_error;
+  }
+};
+
+/**
+* @brief Apply the given options to the calling thread.
+ *
+ * @param options: The settings to apply.
+ * @return The outcome of each setting.
+ */
+RealtimeStatus applyRealtimeOptions(const RealtimeOptions& options);
+
+}  // namespace ackermann
@@ -0,0 +1,63 @@
+#pragma once
+
+/**
+ * @file Replay.hpp
+ * @brief Offline replay of flight recordings through a fresh Controller.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <cstdint>
+#include <limits>
+
+#include "FlightRecorder.hpp"
+
+namespace ackermann {
+
+/**
+* @brief Summary of a replayed recording.
+ */
+struct ReplayResult {
+  /**
+  * @brief Number of control iterations replayed.
+  */
+  uint64_t ticks {0};
+  /**
+  * @brief Number of recorded setState / setGoal calls.
+  */
+  uint64_t inputs {0};
+  /**
+  * @brief Number of iterations whose outputs differed from the recording.
+  */
+  uint64_t divergent_ticks {0};
+  /**
+  * @brief Tick index of the first divergent iteration (if any).
+  */
+  uint64_t first_divergence {std::numeric_limits<uint64_t>::max()};
+  /**
+  * @brief Largest absolute difference of any output.
+  */
+  double max_error {0.0};
+};
+
+/**
+* @brief Replay a recording through a fresh Controller pipeline.
+ *
+ * Iterations are executed back to back with Controller::step(), using the
+ * recorded parameters, time steps, time stamps and the exact state,
+ * setpoint and trajectory feed-forward each recorded iteration consumed;
+ * this makes replay deterministic regardless of how the original inputs
+ * (or trajectories) were interleaved with the control loop. The
+ * replayed outputs (PID terms, limited command and wheel speeds) are
+ * compared against the recorded ones.
+ *
+ * @param log: The recording to replay.
+ * @param tolerance: Largest acceptable absolute difference of any output.
+ * @return A summary of the replay.
+ */
+ReplayResult replay(const FlightLog& log, const double tolerance = 0.0);
+
+}  // namespace ackermann
@@ -0,0 +1,88 @@
+#pragma once
+
+/**
+ * @file Samples.hpp
+ * @brief Timestamped data samples exchanged with the Ackermann controller.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <chrono>
+#include <cstdint>
+
+namespace ackermann {
+
+/**
+* @brief The clock used for all controller timestamps.
+ */
+using Clock = std::chrono::steady_clock;
+
+/**
+* @brief A measurement (or estimate) of the vehicle state.
+ */
+template <typename Scalar>
+struct BasicStateSample {
+  /**
+  * @brief Vehicle speed (m/s).
+  */
+  Scalar speed {0};
+  /**
+  * @brief Vehicle heading (rad).
+  */
+  Scalar heading {0};
+  /**
+  * @brief Time at which the state was measured.
+  */
+  Clock::time_point stamp {};
+};
+
+using StateSample = BasicStateSample<double>;
+
+/**
+* @brief A controller setpoint.
+ */
+template <typename Scalar>
+struct BasicGoalSample {
+  /**
+  * @brief Desired vehicle speed (m/s).
+  */
+  Scalar speed {0};
+  /**
+  * @brief Desired vehicle heading (rad).
+  */
+  Scalar heading {0};
+  /**
+  * @brief Time at which the setpoint was issued.
+  */
+  Clock::time_point stamp {};
+};
+
+using GoalSample = BasicGoalSample<double>;
+
+/**
+* @brief A command produced by the controller.
+ */
+struct CommandSample {
+  /**
+  * @brief Sequence number of the command; starts at 1 and increments with
+  * every command produced (0 means no command has been produced yet).
+  */
+  uint64_t sequence {0};
+  /**
+  * @brief Throttle command (limited between [0,1]).
+  */
+  double throttle {0.0};
+  /**
+  * @brief Steering angle command (rad).
+  */
+  double steering {0.0};
+  /**
+  * @brief Time of the producing iteration (see TelemetryRecord::stamp).
+  */
+  Clock::time_point stamp {};
+};
+
+}  // namespace ackermann
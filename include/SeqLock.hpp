@@ -0,0 +1,336 @@
+#pragma once
+
+/**
+ * @file SeqLock.hpp
+ * @brief Sequence lock primitives used to publish consistent multi-field
+ * data to real-time readers without blocking them.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+
+namespace ackermann {
+
+/**
+* @brief A sequence counter guarding a group of (atomic) fields.
+ *
+ * Writers take exclusive ownership via lock() / unlock() (so this can be
+ * used with std::lock_guard), or lockSingleWriter() / unlockSingleWriter()
+ * when there is only ever one writer; the sequence is odd while a write is in
+ * progress. Readers never block writers: they copy the guarded fields
+ * between readBegin() (or tryReadBegin()) and readRetry() and simply retry
+ * if a write overlapped. The guarded fields must themselves be accessed
+ * atomically (typically with std::memory_order_relaxed).
+ */
+class SequenceLock {
+ public:
+  /**
+  * @brief Acquire exclusive write access, waiting while another writer
+  * holds the lock (see wait()).
+  */
+  void lock() {
+    uint64_t seq = sequence_.load(std::memory_order_relaxed);
+    for (unsigned attempt = 0;
+         (seq & 1)
+         || !sequence_.compare_exchange_weak(seq, seq + 1,
+                                             std::memory_order_acquire,
+                                             std::memory_order_relaxed);
+         ++attempt) {
+      wait(attempt);
+      seq = sequence_.load(std::memory_order_relaxed);
+    }
+    // readers must observe the odd sequence before any guarded write
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  /**
+  * @brief Acquire write access without ever waiting; only valid when the
+  * caller is the sole writer (pair with unlockSingleWriter()).
+  */
+  void lockSingleWriter() {
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+  }
+
+  /**
+  * @brief Release write access, publishing all guarded writes.
+  */
+  void unlock() {
+    sequence_.fetch_add(1, std::memory_order_release);
+  }
+
+  /**
+  * @brief Release write access taken by lockSingleWriter(), publishing all
+  * guarded writes (without an atomic read-modify-write).
+  */
+  void unlockSingleWriter() {
+    sequence_.store(sequence_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_release);
+  }
+
+  /**
+  * @brief Begin a read; waits out any write currently in progress (see
+  * wait()).
+   * @return The sequence value to pass to readRetry().
+   */
+  uint64_t readBegin() const {
+    uint64_t seq = sequence_.load(std::memory_order_acquire);
+    for (unsigned attempt = 0; seq & 1; ++attempt) {
+      wait(attempt);
+      seq = sequence_.load(std::memory_order_acquire);
+    }
+    return seq;
+  }
+
+  /**
+  * @brief Begin a read unless a write is in progress; never waits.
+   * @param start (Return parameter) The sequence value to pass to
+   * readRetry().
+   * @return False if a write is in progress.
+   */
+  bool tryReadBegin(uint64_t& start) const {
+    start = sequence_.load(std::memory_order_acquire);
+    return !(start & 1);
+  }
+
+  /**
+  * @brief Finish a read.
+   * @param start The value returned by the matching readBegin().
+   * @return True if a write overlapped the read (and it must be retried).
+   */
+  bool readRetry(const uint64_t start) const {
+    std::atomic_thread_fence(std::memory_order_acquire);
+    return sequence_.load(std::memory_order_relaxed) != start;
+  }
+
+  /**
+  * @brief Return the number of completed writes.
+  */
+  uint64_t version() const {
+    return sequence_.load(std::memory_order_acquire) / 2;
+  }
+
+ private:
+  /**
+  * @brief Number of attempts spent spinning before wait() sleeps.
+  */
+  static constexpr unsigned kSpins = 64;
+
+  /**
+  * @brief Wait for the holder of the lock to finish its write.
+   *
+   * This spins briefly, then sleeps: unlike yield(), a sleep lets a
+   * preempted, lower priority writer run even when the caller is a
+   * SCHED_FIFO thread sharing its core.
+   *
+   * @param attempt Number of previous attempts.
+   */
+  static void wait(const unsigned attempt) {
+    if (attempt < kSpins) {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#endif
+      return;
+    }
+    std::this_thread::sleep_for(std::chrono::microseconds(50));
+  }
+
+  /**
+  * @brief Sequence number; odd while a write is in progress.
+  */
+  std::atomic<uint64_t> sequence_ {0};
+};
+
+/**
+* @brief A value of (trivially copyable) type T published via a sequence
+* lock.
+ *
+ * Readers obtain a torn-free copy with a handful of relaxed loads and never
+ * block writers; tryLoad() never waits on writers either (e.g. for a
+ * real-time thread, or when writers live in other processes). Concurrent
+ * writers are serialized against each other, unless SingleWriter declares
+ * that there is only ever one writer, which then never waits.
+ * The value is stored as an array of atomic words, so all accesses are
+ * well defined (and the layout is address free, i.e. usable in shared
+ * memory).
+ */
+template <typename T, bool SingleWriter = false>
+class SeqLock {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SeqLock values must be trivially copyable");
+
+ public:
+  /**
+  * @brief Constructor; publishes a default constructed value.
+  */
+  SeqLock() : SeqLock(T()) {}
+
+  /**
+  * @brief Constructor; publishes the given initial value.
+  * @param value The initial value.
+  */
+  explicit SeqLock(const T& value) {
+    store(value);
+  }
+
+  /**
+  * @brief Publish a new value.
+  * @param value The new value.
+  */
+  void store(const T& value) {
+    Words words;
+    toWords(value, words);
+    WriteGuard guard(lock_);
+    for (std::size_t i = 0; i != kWords; ++i)
+      data_[i].store(words[i], std::memory_order_relaxed);
+  }
+
+  /**
+  * @brief Atomically read, modify and publish the current value.
+   *
+   * The given function is executed while holding the write lock, so it
+   * should be short and must not block.
+   *
+   * @param modify Callable invoked as modify(T&).
+   */
+  template <typename Function>
+  void modify(Function&& modify) {
+    WriteGuard guard(lock_);
+    Words words;
+    for (std::size_t i = 0; i != kWords; ++i)
+      words[i] = data_[i].load(std::memory_order_relaxed);
+    T value = fromWords(words);
+    modify(value);
+    toWords(value, words);
+    for (std::size_t i = 0; i != kWords; ++i)
+      data_[i].store(words[i], std::memory_order_relaxed);
+  }
+
+  /**
+  * @brief Return a consistent copy of the current value.
+  */
+  T load() const {
+    Words words;
+    uint64_t seq;
+    do {
+      seq = lock_.readBegin();
+      for (std::size_t i = 0; i != kWords; ++i)
+        words[i] = data_[i].load(std::memory_order_relaxed);
+    } while (lock_.readRetry(seq));
+    return fromWords(words);
+  }
+
+  /**
+  * @brief Read a consistent copy of the current value without waiting on
+  * writers.
+   *
+   * @param value (Return parameter) The current value; left unchanged on
+   * failure.
+   * @param attempts Number of reads to attempt.
+   * @return False if every attempt overlapped a write (such as one by a
+   * preempted or crashed writer).
+   */
+  bool tryLoad(T& value, const unsigned attempts = 1) const {
+    uint64_t version;
+    return tryLoad(value, version, attempts);
+  }
+
+  /**
+  * @brief Read a consistent copy of the current value, and its version,
+  * without waiting on writers.
+   *
+   * @param value (Return parameter) The current value; left unchanged on
+   * failure.
+   * @param version (Return parameter) The number of values published up to
+   * and including the one read (see version()).
+   * @param attempts Number of reads to attempt.
+   * @return False if every attempt overlapped a write.
+   */
+  bool tryLoad(T& value, uint64_t& version, const unsigned attempts) const {
+    Words words;
+    uint64_t seq;
+    for (unsigned attempt = 0; attempt != attempts; ++attempt) {
+      if (!lock_.tryReadBegin(seq))
+        continue;
+      for (std::size_t i = 0; i != kWords; ++i)
+        words[i] = data_[i].load(std::memory_order_relaxed);
+      if (!lock_.readRetry(seq)) {
+        value = fromWords(words);
+        version = seq / 2;
+        return true;
+      }
+    }
+    return false;
+  }
+
+  /**
+  * @brief Return the number of values published so far.
+  */
+  uint64_t version() const {
+    return lock_.version();
+  }
+
+ private:
+  /**
+  * @brief Number of 64 bit words required to hold a T.
+  */
+  static constexpr std::size_t kWords = (sizeof(T) + 7) / 8;
+  using Words = uint64_t[kWords];
+
+  /**
+  * @brief Holds write access for its lifetime.
+  */
+  class WriteGuard {
+   public:
+    explicit WriteGuard(SequenceLock& lock) : lock_(lock) {
+      if (SingleWriter)
+        lock_.lockSingleWriter();
+      else
+        lock_.lock();
+    }
+    ~WriteGuard() {
+      if (SingleWriter)
+        lock_.unlockSingleWriter();
+      else
+        lock_.unlock();
+    }
+
+   private:
+    SequenceLock& lock_;
+  };
+
+  static void toWords(const T& value, Words& words) {
+    std::memset(words, 0, sizeof(words));
+    std::memcpy(words, &value, sizeof(T));
+  }
+
+  static T fromWords(const Words& words) {
+    T value;
+    std::memcpy(&value, words, sizeof(T));
+    return value;
+  }
+
+  /**
+  * @brief Sequence lock guarding our data.
+  */
+  SequenceLock lock_;
+
+  /**
+  * @brief The published value.
+  */
+  std::atomic<uint64_t> data_[kWords];
+};
+
+}  // namespace ackermann
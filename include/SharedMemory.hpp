@@ -0,0 +1,195 @@
+#pragma once
+
+/**
+ * @file SharedMemory.hpp
+ * @brief POSIX shared memory interface to a Controller, for zero-copy
+ * exchange of inputs and outputs with other processes.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include "Notifier.hpp"
+#include "Samples.hpp"
+#include "SeqLock.hpp"
+
+namespace ackermann {
+
+class Controller;
+
+/**
+* @brief Layout of a shared memory segment.
+ *
+ * Every block is a SeqLock (which is address free), and each starts on its
+ * own cache line so that writers in different processes don't contend.
+ * All timestamps are in the (system wide) steady clock.
+ */
+struct SharedBlock {
+  /**
+  * @brief Identifies a segment; checked by clients before use.
+  */
+  static constexpr char kMagic[8] = {'A', 'C', 'K', 'S', 'H', 'M', 'E', 'M'};
+  /**
+  * @brief Layout version; incremented on any incompatible change.
+  */
+  static constexpr uint32_t kVersion = 1;
+
+  /**
+  * @brief Header; version is written last, once the segment is ready.
+  */
+  char magic[8];
+  uint32_t size;
+  std::atomic<uint32_t> version;
+
+  /**
+  * @brief Inputs (written by clients, read by the control loop).
+  */
+  alignas(64) SeqLock<StateSample> state;
+  alignas(64) SeqLock<GoalSample> goal;
+
+  /**
+  * @brief Output (written by the control loop), and the doorbell rung
+  * whenever it changes.
+  */
+  alignas(64) SeqLock<CommandSample, true> command;
+  alignas(64) Notifier command_event {true};
+};
+
+/**
+* @brief Exposes a Controller's inputs and outputs through a named POSIX
+* shared memory segment.
+ *
+ * The control loop polls the input blocks after every iteration (a couple
+ * of atomic loads when nothing has changed) and passes new values to
+ * setState() / setGoal(); every command is published to the output block.
+ * Inputs are read without waiting on their writers, so a client which
+ * crashes (or is descheduled) mid-write can't stall the loop: the
+ * controller keeps its previous input, the miss is counted, and the read
+ * is retried after the next iteration.
+ * The fast path involves no copies beyond the samples themselves and no
+ * system calls, except waking clients blocked in waitForCommand().
+ */
+class SharedServer {
+ public:
+  /**
+  * @brief Constructor; creates (or replaces) the segment and attaches to
+  * the controller.
+   *
+   * @param controller: The controller to expose (must outlive this).
+   * @param name: Segment name, e.g. "/vehicle0" (see shm_open).
+   * @throws std::system_error if the segment can't be created or mapped.
+   */
+  SharedServer(Controller& controller, const std::string& name);
+
+  /**
+  * @brief Destructor; detaches from the controller and removes the segment.
+   *
+   * The controller must not be running. Attached clients keep their
+   * mapping, but are no longer served.
+   */
+  ~SharedServer();
+
+  SharedServer(const SharedServer&) = delete;
+  SharedServer& operator=(const SharedServer&) = delete;
+
+  /**
+  * @brief Return the number of input reads abandoned because a client was
+  * writing; may be called from any thread.
+  */
+  uint64_t missedReads() const;
+
+ private:
+  /**
+  * @brief Exchange data with the segment (executed on the control thread).
+  */
+  void update(const CommandSample& command);
+
+  Controller& controller_;
+  const std::string name_;
+  SharedBlock* block_;
+  std::size_t subscription_;
+
+  /**
+  * @brief Number of inputs already passed to the controller.
+  */
+  uint64_t state_version_;
+  uint64_t goal_version_;
+
+  std::atomic<uint64_t> missed_reads_ {0};
+};
+
+/**
+* @brief Accesses a Controller exposed by a SharedServer in another process.
+ *
+ * All methods are lock free, except waitForCommand(); any number of
+ * clients may attach to a segment.
+ */
+class SharedClient {
+ public:
+  /**
+  * @brief Constructor; maps the named segment.
+   *
+   * @param name: Segment name, as given to the SharedServer.
+   * @throws std::system_error if the segment can't be opened or mapped,
+   * std::runtime_error if it isn't a compatible (or complete) segment.
+   */
+  explicit SharedClient(const std::string& name);
+
+  /**
+  * @brief Destructor; unmaps the segment.
+  */
+  ~SharedClient();
+
+  SharedClient(const SharedClient&) = delete;
+  SharedClient& operator=(const SharedClient&) = delete;
+
+  /**
+  * @brief Publish a new state measurement; see Controller::setState().
+   *
+   * @param state: The actual vehicle state.
+   * @return False if the state was rejected (i.e. isn't finite).
+   */
+  bool setState(const StateSample& state);
+
+  /**
+  * @brief Publish a new setpoint; see Controller::setGoal().
+   *
+   * @param goal: The desired vehicle state.
+   * @return False if the setpoint was rejected (i.e. isn't finite).
+   */
+  bool setGoal(const GoalSample& goal);
+
+  /**
+  * @brief Get a consistent copy of the latest command.
+   *
+   * @param command: The latest command (with a sequence of 0 if none has
+   * been produced yet).
+   */
+  void getCommand(CommandSample& command) const;
+
+  /**
+  * @brief Block until a command newer than the given sequence number is
+  * produced (or the timeout expires); see Controller::waitForCommand().
+   *
+   * @param after: Sequence number of the last command seen by the caller.
+   * @param command: (Return parameter) The latest command.
+   * @param timeout: Maximum time to wait; Clock::duration::max() waits
+   * indefinitely.
+   * @return False on timeout.
+   */
+  bool waitForCommand(const uint64_t after,
+                      CommandSample& command,
+                      const Clock::duration timeout) const;
+
+ private:
+  SharedBlock* block_;
+};
+
+}  // namespace ackermann
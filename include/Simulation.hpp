@@ -0,0 +1,152 @@
+#pragma once
+
+/**
+ * @file Simulation.hpp
+ * @brief Headless closed loop simulation of the controller and fake plant.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <cstdint>
+#include <functional>
+#include <istream>
+#include <string>
+#include <vector>
+
+#include "Params.hpp"
+
+namespace ackermann {
+
+/**
+* @brief A setpoint applied from the given time onwards.
+ */
+struct Setpoint {
+  double time {0.0};
+  double speed {0.0};
+  double heading {0.0};
+};
+
+/**
+* @brief A sensor noise model applied to a measured signal.
+ */
+struct SensorNoise {
+  /**
+  * @brief Available models (see fake/noise.h).
+  */
+  enum class Model {
+    White,       ///< a = mean, b = standard deviation
+    Bias,        ///< a = offset
+    RandomWalk,  ///< a = standard deviation after one second
+    Dropout      ///< a = probability of dropping a sample
+  };
+  bool heading {false};   ///< Corrupt the heading (else the speed).
+  Model model {Model::White};
+  double a {0.0};
+  double b {0.0};
+};
+
+/**
+* @brief Everything needed to run a simulation.
+ *
+ * Scenarios are usually read from a text file (see parseScenario()).
+ */
+struct Scenario {
+  /**
+  * @brief Simulated duration and time step (s).
+  */
+  double duration {10.0};
+  double dt {0.01};
+  /**
+  * @brief Vehicle geometry (m, m, rad).
+  */
+  double wheel_base {0.45};
+  double track_width {0.45};
+  double max_steering_angle {0.785};
+  /**
+  * @brief Controller gains.
+  */
+  PIDGains pid_speed {0.02, 0.0, 0.0};
+  PIDGains pid_heading {0.2, 0.0, 0.0};
+  /**
+  * @brief Initial plant state (m/s, rad).
+  */
+  double initial_speed {0.0};
+  double initial_heading {0.0};
+  /**
+  * @brief Setpoint schedule, in time order.
+  */
+  std::vector<Setpoint> setpoints;
+  /**
+  * @brief Plant process noise, actuator lags and integration (see
+  * fake::PlantOptions).
+  */
+  double noise_mean {0.0};
+  double noise_stddev {0.0};
+  uint64_t seed {0};
+  double throttle_lag {0.0};
+  double steering_lag {0.0};
+  unsigned int substeps {1};
+  /**
+  * @brief Sensor noise models, applied in order.
+  */
+  std::vector<SensorNoise> sensors;
+};
+
+/**
+* @brief Read a scenario.
+ *
+ * Scenarios are line based; '#' starts a comment, and every other line is
+ * a keyword followed by its values:
+ *
+ *   duration <s>                 dt <s>
+ *   vehicle <wheel base> <track width> <max steering angle>
+ *   speed_gains <kp> <ki> <kd>   heading_gains <kp> <ki> <kd>
+ *   initial <speed> <heading>
+ *   setpoint <time> <speed> <heading>        (any number, in time order)
+ *   noise <mean> <stddev>        seed <n>
+ *   lag <throttle time constant> <steering time constant>
+ *   substeps <n>
+ *   sensor <speed|heading> white <mean> <stddev>
+ *   sensor <speed|heading> bias <offset>
+ *   sensor <speed|heading> walk <stddev>
+ *   sensor <speed|heading> dropout <probability>
+ *
+ * @param in: The scenario text.
+ * @return The scenario.
+ * @throws std::runtime_error on malformed input (naming the line).
+ */
+Scenario parseScenario(std::istream& in);
+
+/**
+* @brief The outcome of a single simulated tick.
+ */
+struct SimulationSample {
+  uint64_t tick;
+  double time;              ///< Simulated time at the end of the tick (s).
+  double goal_speed;        ///< Active setpoint.
+  double goal_heading;
+  double speed;             ///< True plant state.
+  double heading;
+  double measured_speed;    ///< Plant state reported to the controller.
+  double measured_heading;
+  double throttle;          ///< Command applied during the tick.
+  double steering;
+};
+
+/**
+* @brief Run a scenario in closed loop: a Controller (executed in lockstep
+* via step()) commanding a fake::Plant.
+ *
+ * @param scenario: The scenario to run.
+ * @param sink: Called with the outcome of every tick.
+ * @param speedup: Simulated seconds per wall clock second; 0 runs as fast
+ * as possible.
+ */
+void simulate(const Scenario& scenario,
+              const std::function<void(const SimulationSample&)>& sink,
+              const double speedup = 0.0);
+
+}  // namespace ackermann
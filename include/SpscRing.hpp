@@ -0,0 +1,205 @@
+#pragma once
+
+/**
+ * @file SpscRing.hpp
+ * @brief Bounded, lock-free single producer / single consumer ring buffer.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+
+namespace ackermann {
+
+/**
+* @brief Storage of an SpscRing with a capacity of N.
+ */
+template <typename T, std::size_t N>
+class SpscRingBuffer {
+ public:
+  static constexpr std::size_t capacity() {
+    return N;
+  }
+  T& operator[](const uint64_t index) {
+    return buffer_[index & (N - 1)];
+  }
+
+ private:
+  std::array<T, N> buffer_ {};
+};
+
+/**
+* @brief Storage of an SpscRing whose capacity is given at construction.
+ */
+template <typename T>
+class SpscRingBuffer<T, 0> {
+ public:
+  /**
+  * @brief Constructor; allocates (and value-initializes) the buffer.
+   * @param capacity: A power of two, or zero (for a ring which is always
+   * full).
+   * @throws std::invalid_argument if the capacity isn't a power of two.
+   */
+  explicit SpscRingBuffer(const std::size_t capacity)
+    : mask_(capacity - 1),
+      buffer_(capacity ? new T[capacity]() : nullptr) {
+    if (capacity & (capacity - 1))
+      throw std::invalid_argument("SpscRing capacity must be a power of 2");
+  }
+  std::size_t capacity() const {
+    return mask_ + 1;
+  }
+  T& operator[](const uint64_t index) {
+    return buffer_[index & mask_];
+  }
+
+ private:
+  const std::size_t mask_;
+  const std::unique_ptr<T[]> buffer_;
+};
+
+/**
+* @brief A fixed capacity FIFO connecting exactly one producer thread to
+* exactly one consumer thread.
+ *
+ * Neither side ever blocks or allocates. When the buffer is full new
+ * values are rejected (and counted) rather than overwriting values the
+ * consumer has not yet seen, so a consumer draining at least once every
+ * capacity() pushes never loses anything.
+ *
+ * @tparam T: Element type (copy assignable).
+ * @tparam N: Capacity; must be a power of two, or zero for a capacity given
+ * at construction (and allocated then).
+ */
+template <typename T, std::size_t N = 0>
+class SpscRing {
+  static_assert(!(N & (N - 1)), "SpscRing capacity must be a power of 2");
+
+ public:
+  SpscRing() = default;
+
+  /**
+  * @brief Constructor, for a capacity given at construction (N == 0).
+   * @param capacity: A power of two, or zero.
+   * @throws std::invalid_argument if the capacity isn't a power of two.
+   */
+  explicit SpscRing(const std::size_t capacity) : buffer_(capacity) {}
+
+  /**
+  * @brief Append a value (producer only).
+   *
+   * @param value: The value to append.
+   * @return False if the buffer was full and the value was dropped.
+   */
+  bool push(const T& value) {
+    const uint64_t head = head_.load(std::memory_order_relaxed);
+    if (head - tail_cache_ == capacity()) {
+      // looks full; refresh our view of the consumer
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head - tail_cache_ == capacity()) {
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+        return false;
+      }
+    }
+    buffer_[head] = value;
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+  /**
+  * @brief Remove the oldest value (consumer only).
+   *
+   * @param value: Set to the removed value.
+   * @return False if the buffer was empty.
+   */
+  bool pop(T& value) {
+    return drain(&value, 1) == 1;
+  }
+
+  /**
+  * @brief Remove up to max of the oldest values, in order (consumer only).
+   *
+   * @param out: Output iterator receiving the removed values.
+   * @param max: Maximum number of values to remove.
+   * @return The number of values removed.
+   */
+  template <typename OutputIt>
+  std::size_t drain(OutputIt out, const std::size_t max = SIZE_MAX) {
+    const uint64_t tail = tail_.load(std::memory_order_relaxed);
+    if (head_cache_ - tail < max)
+      // we may be able to return more; refresh our view of the producer
+      head_cache_ = head_.load(std::memory_order_acquire);
+    std::size_t count = static_cast<std::size_t>(head_cache_ - tail);
+    count = count < max ? count : max;
+    for (std::size_t i = 0; i != count; ++i)
+      *out++ = buffer_[tail + i];
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+  }
+
+  /**
+  * @brief Return the (approximate) number of values currently buffered.
+  */
+  std::size_t size() const {
+    return static_cast<std::size_t>(head_.load(std::memory_order_acquire)
+                                    - tail_.load(std::memory_order_acquire));
+  }
+
+  /**
+  * @brief Return the number of values rejected because the buffer was full.
+  */
+  uint64_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+
+  /**
+  * @brief Return the maximum number of buffered values.
+  */
+  std::size_t capacity() const {
+    return buffer_.capacity();
+  }
+
+ private:
+  // producer and consumer fields live on separate cache lines, so that
+  // neither side's updates invalidate the other's cached view
+  static constexpr std::size_t kCacheLine = 64;
+
+  /**
+  * @brief Total number of values pushed (written by the producer).
+  */
+  std::atomic<uint64_t> head_ {0};
+  /**
+  * @brief The producer's (possibly stale) copy of tail_.
+  */
+  uint64_t tail_cache_ {0};
+  /**
+  * @brief Number of values rejected (written by the producer).
+  */
+  std::atomic<uint64_t> dropped_ {0};
+  char producer_pad_[kCacheLine - 3 * sizeof(uint64_t)];
+
+  /**
+  * @brief Total number of values popped (written by the consumer).
+  */
+  std::atomic<uint64_t> tail_ {0};
+  /**
+  * @brief The consumer's (possibly stale) copy of head_.
+  */
+  uint64_t head_cache_ {0};
+  char consumer_pad_[kCacheLine - 2 * sizeof(uint64_t)];
+
+  /**
+  * @brief Buffered values.
+  */
+  SpscRingBuffer<T, N> buffer_;
+};
+
+}  // namespace ackermann
@@ -0,0 +1,201 @@
+#pragma once
+
+/**
+ * @file StageProfiler.hpp
+ * @brief Lock-free per-stage profiling of the control loop pipeline.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+
+#include "SpscRing.hpp"
+#include "TimingStats.hpp"
+
+namespace ackermann {
+
+/**
+* @brief The stages of a single control loop iteration, in order.
+ */
+enum class Stage : std::size_t {
+  Inputs,     ///< Trajectory, state, goal and command reads.
+  PID,        ///< Throttle and heading PIDs (and feed-forward).
+  Limits,     ///< Limits::limit().
+  Model,      ///< Model::command() (and the command history).
+  Publish,    ///< Command publication and subscriber callbacks.
+  Telemetry,  ///< Telemetry and flight recording.
+  Count
+};
+
+/**
+* @brief Return the (lower case) name of the given stage.
+*/
+const char* stageName(const Stage stage);
+
+/**
+* @brief Summary of the time spent in a single stage.
+ *
+ * All durations are in nanoseconds.
+ */
+struct StageStats {
+  /**
+  * @brief Number of recorded executions.
+  */
+  uint64_t count {0};
+  /**
+  * @brief Shortest and longest (exact) durations.
+  */
+  uint64_t min {0};
+  uint64_t max {0};
+  /**
+  * @brief Mean (exact) duration.
+  */
+  double mean {0.0};
+  /**
+  * @brief Distribution of durations, for percentiles.
+  */
+  Histogram::Snapshot durations;
+};
+
+/**
+* @brief The timeline of a single iteration.
+ */
+struct StageTrace {
+  /**
+  * @brief Iteration index.
+  */
+  uint64_t tick {0};
+  /**
+  * @brief Time at which the iteration began.
+  */
+  std::chrono::steady_clock::time_point start {};
+  /**
+  * @brief Time (since start, in ns) at which each stage ended.
+  */
+  uint64_t end[static_cast<std::size_t>(Stage::Count)] {};
+};
+
+/**
+* @brief Collector of per-stage timing; written by the control thread and
+* readable from any thread without locks.
+ *
+ * Each iteration calls begin(), then mark() as each stage completes (in
+ * order) and finally end(). Stage durations accumulate into per-stage
+ * statistics, and the timeline of each iteration is buffered (up to
+ * TraceRing::capacity()) for export by a single consumer.
+ *
+ * The Controller only records stages when built with
+ * ACKERMANN_PROFILE_STAGES (the CMake option PROFILE_STAGES); otherwise
+ * the instrumentation is compiled out entirely.
+ */
+class StageProfiler {
+ public:
+  /**
+  * @brief Number of stages.
+  */
+  static constexpr std::size_t kStages =
+    static_cast<std::size_t>(Stage::Count);
+
+  /**
+  * @brief Buffer of iteration timelines; holds 10s of data at the default
+  * control frequency.
+  */
+  using TraceRing = SpscRing<StageTrace, 1024>;
+
+  /**
+  * @brief Begin an iteration (control thread only).
+   *
+   * @param tick: Iteration index.
+   */
+  void begin(const uint64_t tick);
+
+  /**
+  * @brief Complete a stage, begun when the previous stage (or the
+  * iteration) completed (control thread only).
+   *
+   * @param stage: The stage completed.
+   */
+  void mark(const Stage stage);
+
+  /**
+  * @brief Complete an iteration, buffering its timeline (control thread
+  * only).
+  */
+  void end();
+
+  /**
+  * @brief Return a copy of the statistics of the given stage.
+  */
+  StageStats stats(const Stage stage) const;
+
+  /**
+  * @brief Clear all statistics (not buffered timelines).
+  */
+  void reset();
+
+  /**
+  * @brief Retrieve the timelines recorded since the previous call (single
+  * consumer only).
+   *
+   * @param traces: Array receiving the oldest timelines, in order.
+   * @param max: The size of the traces array.
+   * @return The number of timelines retrieved.
+   */
+  std::size_t drainTrace(StageTrace* traces, const std::size_t max);
+
+  /**
+  * @brief Return the number of timelines discarded because they weren't
+  * drained in time.
+  */
+  uint64_t traceDropped() const;
+
+ private:
+  /**
+  * @brief Statistics of a single stage (written by the control thread).
+  */
+  struct Accumulator {
+    std::atomic<uint64_t> count {0};
+    std::atomic<uint64_t> total {0};
+    std::atomic<uint64_t> min {UINT64_MAX};
+    std::atomic<uint64_t> max {0};
+    Histogram durations;
+  };
+
+  Accumulator stages_[kStages];
+
+  /**
+  * @brief The iteration in progress (control thread only).
+  */
+  StageTrace current_;
+  std::chrono::steady_clock::time_point last_ {};
+
+  TraceRing traces_;
+};
+
+/**
+* @brief Write the given timelines as Chrome trace-event JSON, which can be
+* loaded into chrome://tracing or Perfetto.
+ *
+ * Each iteration is a "tick" event enclosing one event per stage.
+ *
+ * @param out: Stream to write to.
+ * @param traces: Array of timelines.
+ * @param count: Number of timelines.
+ */
+void writeChromeTrace(std::ostream& out,
+                      const StageTrace* traces,
+                      const std::size_t count);
+
+/**
+* @brief Write a human readable summary of every stage's statistics.
+ */
+std::ostream& operator<<(std::ostream& out, const StageProfiler& profiler);
+
+}  // namespace ackermann
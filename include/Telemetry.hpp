@@ -0,0 +1,107 @@
+#pragma once
+
+/**
+ * @file Telemetry.hpp
+ * @brief Per-iteration record of the Ackermann controller's internals.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <cstddef>
+#include <cstdint>
+
+#include "Samples.hpp"
+#include "PID.hpp"
+#include "SpscRing.hpp"
+
+namespace ackermann {
+
+/**
+* @brief Everything computed during a single control loop iteration.
+ *
+ * All values belong to the same iteration, so (unlike separate getter
+ * calls) they are always mutually consistent.
+ */
+struct TelemetryRecord {
+  /**
+  * @brief Iteration index (monotonically increasing).
+  */
+  uint64_t tick {0};
+  /**
+  * @brief Time of the iteration: its scheduled time, or the time given to
+  * Controller::step().
+  */
+  Clock::time_point stamp {};
+  /**
+  * @brief State consumed by the iteration.
+  */
+  StateSample state;
+  /**
+  * @brief Setpoint consumed by the iteration.
+  */
+  GoalSample goal;
+  /**
+  * @brief Speed error (m/s).
+  */
+  double speed_error {0.0};
+  /**
+  * @brief Heading error, along the shortest arc (rad).
+  */
+  double heading_error {0.0};
+  /**
+  * @brief Throttle error fed to the throttle PID.
+  */
+  double throttle_error {0.0};
+  /**
+  * @brief Terms of the throttle PID.
+  */
+  PIDTerms throttle_terms;
+  /**
+  * @brief Terms of the heading PID.
+  */
+  PIDTerms heading_terms;
+  /**
+  * @brief Trajectory feed-forward added to the throttle command.
+  */
+  double throttle_feed_forward {0.0};
+  /**
+  * @brief Trajectory feed-forward added to the steering command (rad).
+  */
+  double steering_feed_forward {0.0};
+  /**
+  * @brief Limited throttle command.
+  */
+  double throttle {0.0};
+  /**
+  * @brief Limited steering angle command (rad).
+  */
+  double steering {0.0};
+  /**
+  * @brief Steering angle velocity (rad/s).
+  */
+  double steering_vel {0.0};
+  /**
+  * @brief Resulting wheel linear velocities (m/s).
+  */
+  double wheel_left_front {0.0};
+  double wheel_right_front {0.0};
+  double wheel_left_rear {0.0};
+  double wheel_right_rear {0.0};
+};
+
+/**
+* @brief Buffer of telemetry between the control loop and its consumer,
+* with a capacity given at construction.
+ */
+using TelemetryRing = SpscRing<TelemetryRecord>;
+
+/**
+* @brief A telemetry capacity holding 10s of data at the default control
+* frequency.
+ */
+constexpr std::size_t kDefaultTelemetryCapacity = 1024;
+
+}  // namespace ackermann
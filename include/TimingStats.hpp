@@ -0,0 +1,255 @@
+#pragma once
+
+/**
+ * @file TimingStats.hpp
+ * @brief Lock-free instrumentation of control loop timing.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <ostream>
+#include <thread>
+
+namespace ackermann {
+
+/**
+* @brief A log-linear (HDR style) histogram of non-negative integer values.
+ *
+ * Every power of two range is divided into kSubBuckets linear buckets, so
+ * any recorded value is reproduced to within 1/kSubBuckets (6.25%) over
+ * the entire 64 bit range with a fixed amount of memory. Recording is wait
+ * free and may happen concurrently with any number of readers.
+ */
+class Histogram {
+ public:
+  /**
+  * @brief Number of bits of precision retained per value.
+  */
+  static constexpr unsigned kSubBucketBits = 4;
+  /**
+  * @brief Number of linear buckets per power of two.
+  */
+  static constexpr std::size_t kSubBuckets = 1u << kSubBucketBits;
+  /**
+  * @brief Total number of buckets.
+  */
+  static constexpr std::size_t kBuckets = (65 - kSubBucketBits) * kSubBuckets;
+
+  /**
+  * @brief A plain copy of the bucket counts, used for analysis.
+  */
+  class Snapshot {
+   public:
+    /**
+    * @brief Return the total number of recorded values.
+    */
+    uint64_t count() const;
+
+    /**
+    * @brief Return the (approximate) value below which the given fraction
+    * of all recorded values fall.
+     *
+     * @param quantile: Fraction in [0, 1]; e.g. 0.99 for the 99th percentile.
+     * @return The highest value equivalent to the matching bucket, or 0 if
+     * nothing has been recorded.
+     */
+    uint64_t percentile(const double quantile) const;
+
+    /**
+    * @brief Return the (approximate) largest recorded value.
+    */
+    uint64_t max() const;
+
+    /**
+    * @brief Return the (approximate) mean recorded value.
+    */
+    double mean() const;
+
+    /**
+    * @brief Bucket counts.
+    */
+    std::array<uint64_t, kBuckets> counts {};
+  };
+
+  /**
+  * @brief Record a single value.
+   *
+   * @param value: The value to record.
+   */
+  void record(const uint64_t value) {
+    counts_[bucket(value)].fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+  * @brief Return a copy of the current bucket counts.
+   *
+   * Values recorded concurrently may or may not be included.
+   */
+  Snapshot snapshot() const;
+
+  /**
+  * @brief Clear all recorded values.
+  */
+  void reset();
+
+  /**
+  * @brief Return the bucket index of the given value.
+  */
+  static std::size_t bucket(const uint64_t value) {
+    if (value < kSubBuckets)
+      return static_cast<std::size_t>(value);
+    // position of the most significant bit, and the kSubBucketBits below it
+    const unsigned msb = 63 - __builtin_clzll(value);
+    const unsigned shift = msb - kSubBucketBits;
+    return ((shift + 1) << kSubBucketBits)
+      + static_cast<std::size_t>((value >> shift) - kSubBuckets);
+  }
+
+  /**
+  * @brief Return the highest value which maps to the given bucket.
+  */
+  static uint64_t bucketValue(const std::size_t bucket);
+
+ private:
+  /**
+  * @brief Number of values recorded in each bucket.
+  */
+  std::array<std::atomic<uint64_t>, kBuckets> counts_ {};
+};
+
+/**
+* @brief A consistent summary of control loop timing.
+ *
+ * All durations are in nanoseconds.
+ */
+struct TimingStats {
+  /**
+  * @brief Number of completed loop iterations.
+  */
+  uint64_t iterations {0};
+  /**
+  * @brief Number of iterations which finished after their deadline (the
+  * start of the following tick).
+  */
+  uint64_t overruns {0};
+  /**
+  * @brief Number of ticks skipped entirely because the loop fell behind.
+  */
+  uint64_t missed_ticks {0};
+  /**
+  * @brief Largest delay between a tick's scheduled and actual start.
+  */
+  uint64_t max_lateness {0};
+  /**
+  * @brief Distribution of the time between successive iteration starts.
+  */
+  Histogram::Snapshot period;
+  /**
+  * @brief Distribution of the time spent executing each iteration.
+  */
+  Histogram::Snapshot compute;
+};
+
+/**
+* @brief Collector of control loop timing; written by the loop thread and
+* readable from any thread without locks.
+ */
+class TimingRecorder {
+ public:
+  /**
+  * @brief Record a single loop iteration.
+   *
+   * @param period: Time since the start of the previous iteration (ns);
+   * 0 for the first iteration.
+   * @param compute: Time spent executing the iteration (ns).
+   * @param lateness: Delay between scheduled and actual start (ns).
+   * @param overrun: Whether the iteration finished after its deadline.
+   * @param missed: Number of ticks skipped after this iteration.
+   */
+  void record(const uint64_t period,
+              const uint64_t compute,
+              const uint64_t lateness,
+              const bool overrun,
+              const uint64_t missed);
+
+  /**
+  * @brief Return a copy of the statistics recorded so far.
+  */
+  TimingStats stats() const;
+
+  /**
+  * @brief Clear all statistics.
+  */
+  void reset();
+
+ private:
+  std::atomic<uint64_t> iterations_ {0};
+  std::atomic<uint64_t> overruns_ {0};
+  std::atomic<uint64_t> missed_ticks_ {0};
+  std::atomic<uint64_t> max_lateness_ {0};
+  Histogram period_;
+  Histogram compute_;
+};
+
+/**
+* @brief Periodically reports control loop timing problems from a
+* background thread, keeping all I/O off the control thread.
+ *
+ * A line is written whenever the number of overruns or missed ticks has
+ * increased since the previous check.
+ */
+class TimingLogger {
+ public:
+  /**
+  * @brief Constructor; begins monitoring immediately.
+   *
+   * @param source: Callable returning the latest TimingStats, e.g.
+   * [&controller](){ return controller.getTimingStats(); }
+   * @param out: Stream to report to (must outlive this object).
+   * @param interval: Time between checks.
+   */
+  TimingLogger(std::function<TimingStats()> source,
+               std::ostream& out,
+               const std::chrono::milliseconds interval
+                 = std::chrono::milliseconds(1000));
+
+  /**
+  * @brief Destructor; stops and joins the monitoring thread.
+  */
+  ~TimingLogger();
+
+  TimingLogger(const TimingLogger&) = delete;
+  TimingLogger& operator=(const TimingLogger&) = delete;
+
+ private:
+  /**
+  * @brief Monitoring loop (executed asynchronously).
+  */
+  void loop();
+
+  std::function<TimingStats()> source_;
+  std::ostream& out_;
+  const std::chrono::milliseconds interval_;
+  std::mutex mutex_;
+  std::condition_variable wake_;
+  bool cancel_ {false};
+  std::thread handle_;
+};
+
+/**
+* @brief Write a human readable summary of the given statistics.
+ */
+std::ostream& operator<<(std::ostream& out, const TimingStats& stats);
+
+}  // namespace ackermann
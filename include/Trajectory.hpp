@@ -0,0 +1,145 @@
+#pragma once
+
+/**
+ * @file Trajectory.hpp
+ * @brief Lock-free queue of time-stamped setpoints, interpolated by the
+ * control loop.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "Samples.hpp"
+#include "SpscRing.hpp"
+
+namespace ackermann {
+
+/**
+* @brief A setpoint interpolated from a Trajectory.
+ */
+struct TrajectorySetpoint {
+  /**
+  * @brief Desired speed and heading (stamped with the sampled time).
+  */
+  GoalSample goal;
+  /**
+  * @brief Rate of change of the desired speed (m/s^2).
+  */
+  double speed_rate {0.0};
+  /**
+  * @brief Rate of change of the desired heading (rad/s).
+  */
+  double heading_rate {0.0};
+};
+
+/**
+* @brief A motion profile of time-stamped (speed, heading) knots, appended
+* by one producer thread and sampled by the control loop.
+ *
+ * Each knot is a GoalSample whose stamp is the time at which the vehicle
+ * should reach it. The control loop samples the trajectory at its exact
+ * tick time, interpolating linearly between the surrounding knots (heading
+ * along the shortest arc). Before the first knot's time the trajectory is
+ * inactive; once the latest knot's time has passed that knot is held (and
+ * interpolation resumes from it when more are appended) until clear().
+ *
+ * Knots are stored in a preallocated SpscRing, so neither appending nor
+ * sampling ever blocks or allocates.
+ */
+class Trajectory {
+ public:
+  /**
+  * @brief Maximum number of knots not yet reached by the control loop.
+  */
+  static constexpr std::size_t kCapacity = 1024;
+
+  /**
+  * @brief Append a knot (producer only).
+   *
+   * @param knot: The setpoint to reach, at knot.stamp.
+   * @return False if the knot was rejected: the buffer is full, the knot
+   * isn't finite, or it isn't later than the previously appended knot.
+   */
+  bool append(const GoalSample& knot);
+
+  /**
+  * @brief Append a sequence of knots, in order (producer only).
+   *
+   * @param knots: Array of knots.
+   * @param count: Number of knots.
+   * @return The number of knots appended (appending stops at the first
+   * rejected knot).
+   */
+  std::size_t append(const GoalSample* knots, const std::size_t count);
+
+  /**
+  * @brief Discard every knot (producer only).
+   *
+   * The control loop stops following the trajectory on its next tick;
+   * knots appended afterwards begin a new trajectory.
+  */
+  void clear();
+
+  /**
+  * @brief Return the (approximate) number of knots not yet consumed by the
+  * control loop.
+  */
+  std::size_t pending() const;
+
+  /**
+  * @brief Sample the trajectory at the given time (consumer only).
+   *
+   * @param now: The time to sample at.
+   * @param setpoint: (Return parameter) The interpolated setpoint.
+   * @return False if the trajectory is inactive (no knot has been reached
+   * since the last clear()).
+   */
+  bool sample(const Clock::time_point now, TrajectorySetpoint& setpoint);
+
+ private:
+  /**
+  * @brief A knot, tagged with the number of clear() calls preceding it.
+  */
+  struct Knot {
+    GoalSample goal;
+    uint64_t epoch;
+  };
+
+  /**
+  * @brief Take the next knot of the current epoch into previous_/next_.
+   * @return False if none is available.
+   */
+  bool advance();
+
+  /**
+  * @brief Knots appended but not yet consumed.
+  */
+  SpscRing<Knot, kCapacity> knots_;
+
+  /**
+  * @brief Number of calls to clear().
+  */
+  std::atomic<uint64_t> epoch_ {0};
+
+  /**
+  * @brief Stamp of the last knot appended (producer only).
+  */
+  Clock::time_point last_stamp_ {Clock::time_point::min()};
+
+  /**
+  * @brief The knots surrounding the current time (consumer only); count_
+  * of them are valid.
+  */
+  uint64_t consumer_epoch_ {0};
+  GoalSample previous_;
+  GoalSample next_;
+  std::size_t count_ {0};
+};
+
+}  // namespace ackermann
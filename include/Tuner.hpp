@@ -0,0 +1,152 @@
+#pragma once
+
+/**
+ * @file Tuner.hpp
+ * @brief Offline PID gain tuning against simulated closed loop scenarios.
+ *
+ * @author Spencer Elyard
+ * @author Daniel M. Sahu
+ * @author Santosh Kesani
+ * @copyright [2020]
+ */
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Params.hpp"
+
+namespace ackermann {
+
+/**
+* @brief A single closed loop step response to simulate.
+ */
+struct TuningScenario {
+  /**
+  * @brief Initial vehicle speed (m/s) and heading (rad).
+  */
+  double initial_speed {0.0};
+  double initial_heading {0.0};
+  /**
+  * @brief Setpoint speed (m/s) and heading (rad).
+  */
+  double goal_speed {0.0};
+  double goal_heading {0.0};
+  /**
+  * @brief Simulated duration (s).
+  */
+  double duration {5.0};
+};
+
+/**
+* @brief Options controlling how candidate gains are scored and searched.
+ */
+struct TuningOptions {
+  /**
+  * @brief Scenarios every candidate is evaluated on; if empty a default
+  * set of speed and heading steps is used.
+  */
+  std::vector<TuningScenario> scenarios;
+  /**
+  * @brief Simulation time step (s).
+  */
+  double dt {0.01};
+  /**
+  * @brief Width of the settling band, as a fraction of each step's size.
+  */
+  double settling_band {0.05};
+  /**
+  * @brief Cost weights of the settling time (per second), overshoot (per
+  * step size) and integrated absolute error (per step size second).
+  */
+  double settling_weight {1.0};
+  double overshoot_weight {2.0};
+  double error_weight {1.0};
+  /**
+  * @brief Number of independent Nelder-Mead searches; the first starts
+  * from the given gains, the rest from random perturbations of them.
+  */
+  std::size_t starts {16};
+  /**
+  * @brief Maximum number of candidate evaluations per search.
+  */
+  std::size_t evaluations {400};
+  /**
+  * @brief Number of worker threads (0 uses every hardware thread).
+  */
+  unsigned int threads {0};
+  /**
+  * @brief Seed for the random starting points (results are identical for
+  * a given seed, regardless of the number of threads).
+  */
+  uint64_t seed {0};
+};
+
+/**
+* @brief Step response metrics of a set of gains, summed over all
+* scenarios (and over the speed and heading responses).
+ */
+struct TuningScore {
+  /**
+  * @brief Time until the response stays within the settling band (s).
+  */
+  double settling_time {0.0};
+  /**
+  * @brief Largest excursion past the setpoint (fraction of step size).
+  */
+  double overshoot {0.0};
+  /**
+  * @brief Integrated absolute error (fraction of step size times s).
+  */
+  double error {0.0};
+  /**
+  * @brief Weighted total (infinite if the response diverged).
+  */
+  double cost {0.0};
+};
+
+/**
+* @brief The best gains found by tune().
+ */
+struct TuningResult {
+  /**
+  * @brief Speed and heading controller gains.
+  */
+  PIDGains pid_speed;
+  PIDGains pid_heading;
+  /**
+  * @brief Score of these gains.
+  */
+  TuningScore score;
+  /**
+  * @brief Total number of candidates evaluated.
+  */
+  std::size_t evaluations {0};
+};
+
+/**
+* @brief Score the gains of the given parameters.
+ *
+ * Each scenario is simulated faster than real time with a Controller
+ * (executed via step()) in closed loop with a fake::Plant.
+ *
+ * @param params: Vehicle parameters, including the gains to evaluate.
+ * @param options: Scenarios and cost weights.
+ * @return The summed score.
+ */
+TuningScore evaluate(const ParamsSnapshot& params,
+                     const TuningOptions& options);
+
+/**
+* @brief Search for the speed and heading PID gains minimizing the cost.
+ *
+ * Several Nelder-Mead searches over the six (non-negative) gains run in
+ * parallel, and the best result of any of them is returned.
+ *
+ * @param params: Vehicle parameters, including the initial gains.
+ * @param options: Scenarios, cost weights and search settings.
+ * @return The best gains found.
+ */
+TuningResult tune(const ParamsSnapshot& params, const TuningOptions& options);
+
+}  // namespace ackermann
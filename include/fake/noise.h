@@ -0,0 +1,199 @@
+#pragma once
+/**
+ * @file noise.h
+ * @brief Reproducible random number and noise models for the fake plant.
+ *
+ * @author Daniel M.
+ *
+ * @copyright [2020]
+ */
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+/**
+* @brief Namespace for fake plant model implementation
+*/
+namespace fake {
+
+/**
+* @brief A fast counter based random number generator.
+ *
+ * Each output is a fixed hash (the SplitMix64 finalizer) of the seed, the
+ * stream and a counter, so the sequence is identical on every platform and
+ * standard library, and distinct streams of the same seed are independent.
+ */
+class Random {
+ public:
+  /**
+  * @brief Constructor
+  * @param seed Seed shared by all related streams (e.g. a whole run).
+  * @param stream Identifier of this stream (e.g. the plant index).
+  */
+  Random(const uint64_t seed, const uint64_t stream);
+
+  /**
+  * @brief Return the next 64 random bits.
+  */
+  uint64_t next();
+
+  /**
+  * @brief Return the next uniformly distributed value in [0, 1).
+  */
+  double uniform();
+
+ private:
+  /**
+  * @brief Counter, starting at a hash of the seed and stream.
+  */
+  uint64_t counter_;
+};
+
+/**
+* @brief A source of standard normal samples, generated in batches.
+ *
+ * Samples are produced by the polar Box-Muller method (no trigonometry), a
+ * batch at a time into a fixed buffer, so drawing a sample is usually a
+ * single load.
+ */
+class NoiseSource {
+ public:
+  /**
+  * @brief Constructor
+  * @param seed Seed shared by all related sources.
+  * @param stream Identifier of this source.
+  */
+  NoiseSource(const uint64_t seed, const uint64_t stream);
+
+  /**
+  * @brief Return the next standard normal sample.
+  */
+  double gaussian() {
+    if (index_ == kBatch)
+      refill();
+    return buffer_[index_++];
+  }
+
+  /**
+  * @brief Return the next uniformly distributed value in [0, 1).
+  */
+  double uniform() {
+    return random_.uniform();
+  }
+
+ private:
+  /**
+  * @brief Number of samples generated at once (must be even).
+  */
+  static constexpr std::size_t kBatch = 64;
+
+  /**
+  * @brief Generate the next batch of samples.
+  */
+  void refill();
+
+  Random random_;
+  std::array<double, kBatch> buffer_;
+  std::size_t index_ {kBatch};
+};
+
+/**
+* @brief Interface of a model corrupting a signal.
+ */
+class NoiseModel {
+ public:
+  virtual ~NoiseModel() = default;
+
+  /**
+  * @brief Clear any internal state.
+  */
+  virtual void reset() {}
+
+  /**
+  * @brief Corrupt the given value.
+   *
+   * @param value: The value to corrupt.
+   * @param dt: Time since the previous value (s).
+   * @param source: Random samples to use.
+   * @return The corrupted value.
+   */
+  virtual double apply(const double value, const double dt,
+                       NoiseSource& source) = 0;
+};
+
+/**
+* @brief Additive Gaussian white noise.
+ */
+class WhiteNoise : public NoiseModel {
+ public:
+  WhiteNoise(const double mean, const double stddev)
+    : mean_(mean), stddev_(stddev) {}
+  double apply(const double value, const double,
+               NoiseSource& source) override {
+    return value + mean_ + stddev_ * source.gaussian();
+  }
+
+ private:
+  const double mean_;
+  const double stddev_;
+};
+
+/**
+* @brief A constant offset.
+ */
+class Bias : public NoiseModel {
+ public:
+  explicit Bias(const double bias) : bias_(bias) {}
+  double apply(const double value, const double, NoiseSource&) override {
+    return value + bias_;
+  }
+
+ private:
+  const double bias_;
+};
+
+/**
+* @brief An offset drifting as a random walk (Brownian motion).
+ */
+class RandomWalk : public NoiseModel {
+ public:
+  /**
+  * @brief Constructor
+  * @param stddev Standard deviation of the drift after one second.
+  */
+  explicit RandomWalk(const double stddev) : stddev_(stddev) {}
+  void reset() override {
+    offset_ = 0.0;
+  }
+  double apply(const double value, const double dt,
+               NoiseSource& source) override;
+
+ private:
+  const double stddev_;
+  double offset_ {0.0};
+};
+
+/**
+* @brief Randomly dropped samples; the previous value is repeated instead.
+ */
+class Dropout : public NoiseModel {
+ public:
+  /**
+  * @brief Constructor
+  * @param probability Probability of dropping each sample.
+  */
+  explicit Dropout(const double probability) : probability_(probability) {}
+  void reset() override {
+    valid_ = false;
+  }
+  double apply(const double value, const double,
+               NoiseSource& source) override;
+
+ private:
+  const double probability_;
+  double last_ {0.0};
+  bool valid_ {false};
+};
+
+}  // namespace fake
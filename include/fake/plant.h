@@ -12,13 +12,14 @@
 #include <iostream>
 #include <limits>
 #include <cmath>
-#include <random>
 #include <atomic>
 #include <memory>
 #include <thread>
 #include <chrono>
+#include <vector>
 #include "Params.hpp"
 #include "Limits.hpp"
+#include "fake/noise.h"
 
 /**
 * @brief Namespace for fake plant model implementation
@@ -48,6 +49,32 @@ struct PlantOptions {
   * @brief StdDev noise parameter for noise modeling.
   */
   double noise_stddev {0.0};
+  /**
+  * @brief Seed of all random noise; plants with the same seed and stream
+  * produce identical noise.
+  */
+  uint64_t noise_seed {0};
+  /**
+  * @brief Noise stream of this plant (e.g. its index in a batch of
+  * parallel simulations).
+  */
+  uint64_t noise_stream {0};
+
+  // actuator and integration parameters
+  /**
+  * @brief Time constant of the first order lag between the throttle
+  * command and the vehicle speed (s); 0 responds instantly.
+  */
+  double throttle_time_constant {0.0};
+  /**
+  * @brief Time constant of the first order lag between the steering
+  * command and the steering angle (s); 0 responds instantly.
+  */
+  double steering_time_constant {0.0};
+  /**
+  * @brief Number of RK4 integration steps per command.
+  */
+  unsigned int substeps {1};
 
   /* Delete default constructor */
   PlantOptions() = delete;
@@ -73,6 +100,14 @@ struct PlantOptions {
  */
 class Plant {
  public:
+  /**
+  * @brief Measured signals.
+  */
+  enum class Signal {
+    Speed,
+    Heading
+  };
+
    /**
    * @brief Constructor
     *
@@ -84,7 +119,10 @@ class Plant {
 
   /**
   * @brief Reset all state variables to their defaults.
-  */
+   *
+   * This also restarts the noise stream, so a reset plant reproduces the
+   * same noise.
+   */
   void reset();
 
   /**
@@ -103,13 +141,46 @@ class Plant {
    */
   void getState(double& speed, double& heading) const;
 
+  /**
+  * @brief Corrupt measurements of the given signal with a noise model.
+   *
+   * Models are applied in the order they are added. Unlike the process
+   * noise (PlantOptions::noise_mean and noise_stddev), these only affect
+   * getMeasurement(), not the state of the vehicle.
+   *
+   * @param signal: The signal to corrupt.
+   * @param model: The noise model.
+   */
+  void addSensorNoise(const Signal signal, std::unique_ptr<NoiseModel> model);
+
+  /**
+  * @brief Get the current system state, as measured by our (noisy)
+  * sensors.
+   *
+   * This is updated by each command(); it equals getState() if no sensor
+   * noise was added.
+   *
+   * @param speed: The measured system speed.
+   * @param heading: The measured system heading.
+   */
+  void getMeasurement(double& speed, double& heading) const;
+
+  /**
+  * @brief Get the current (lagged) steering angle of the vehicle.
+   *
+   * @param steering: The current steering angle (rad).
+   */
+  void getSteering(double& steering) const;
+
   /**
   * @brief Simulate an actual command to the vehicle.
    *
-   * This is a very simple approximation of the plant; the throttle
-   * command is assumed to translate instantly into the new speed,
-   * and the new heading is calculated by integrating the effect of
-   * the new steering angle over the timestep.
+   * The speed and steering angle follow their commands through first order
+   * lags (see PlantOptions), and the heading integrates the bicycle model;
+   * the combined system is integrated with substeps fixed RK4 steps, so
+   * large time steps remain accurate. With no lags the throttle translates
+   * instantly into the new speed, and the heading is integrated exactly
+   * over the timestep.
    *
    * @param throttle: The throttle command to apply.
    * @param steering: The steering command to apply.
@@ -126,6 +197,10 @@ class Plant {
   * @brief heading variable
   */
   double heading_;
+  /**
+  * @brief steering angle variable
+  */
+  double steering_;
 
   /**
   * @brief struct of our system options
@@ -137,11 +212,18 @@ class Plant {
   */
   std::shared_ptr<const ackermann::Params> params_;
 
+  /**
+  * @brief measured speed and heading variables
+  */
+  double measured_speed_;
+  double measured_heading_;
+
   /**
   * @brief random noise generation
   */
-  std::default_random_engine generator_;
-  std::normal_distribution<double> dist_;
+  NoiseSource noise_;
+  std::vector<std::unique_ptr<NoiseModel>> speed_noise_;
+  std::vector<std::unique_ptr<NoiseModel>> heading_noise_;
 
   /**
   * @brief Object used to apply kinematic constraints to
@@ -6,6 +6,7 @@
 #include <chrono>
 #include <iostream>
 #include <limits>
+#include <vector>
 #include <Controller.hpp>
 #include <Params.hpp>
 #include "fake/plant.h"
@@ -45,7 +46,8 @@ class AckermannControllerTest : public ::testing::Test {
     plant_ = std::make_unique<fake::Plant>(*opts_, params_);
 
     // construct the controller
-    controller_ = std::make_unique<ackermann::Controller>(params_);
+    controller_ = std::make_unique<ackermann::Controller>(
+      params_, ackermann::kDefaultTelemetryCapacity);
 
     // construct our limits class
     limits_ = std::make_unique<ackermann::Limits>(params_);
@@ -89,12 +91,20 @@ bool control_loop(std::unique_ptr<fake::Plant>& p,
   // success count (makes sure we don't just get lucky)
   unsigned int success_count = 0;
 
+  // latest command, and a buffer for the controller's telemetry
+  double throttle = 0.0, steering = 0.0;
+  std::vector<ackermann::TelemetryRecord> records(
+    c->getTelemetryCapacity());
+
   // loop until we've ran out of time
   while (duration_cast<seconds>(steady_clock::now() - start).count()
          < max_duration) {
-    // calculate latest command
-    double throttle, steering;
-    c->getCommand(throttle, steering);
+    // retrieve the latest command (from a single control loop iteration)
+    std::size_t count = c->drainTelemetry(records.data(), records.size());
+    if (count) {
+      throttle = records[count - 1].throttle;
+      steering = records[count - 1].steering;
+    }
 
     // apply the command to our plant
     p->command(throttle, steering, dt);
@@ -116,6 +126,57 @@ bool control_loop(std::unique_ptr<fake::Plant>& p,
     // check if we should break (stopped running, etc.)
     if (!c->isRunning())
       return false;
+
+    // give the control thread a chance to execute (on single core machines)
+    std::this_thread::yield();
+  }
+
+  // if we've gotten this far, we've failed
+  return false;
+}
+
+/* @brief A convenience method for executing the given controller's
+ * command against the given Plant in lockstep (simulated time).
+ *
+ */
+bool lockstep_loop(std::unique_ptr<fake::Plant>& p,
+                   std::unique_ptr<ackermann::Controller>& c,
+                   double desired_speed,
+                   double desired_heading,
+                   double max_duration,
+                   double speed_tolerance = 0.1,
+                   double heading_tolerance = 0.1) {
+  double dt = 1.0/CONTROL_FREQUENCY;
+
+  // set goals
+  c->setGoal(desired_speed, desired_heading);
+
+  // success count (makes sure we don't just get lucky)
+  unsigned int success_count = 0;
+
+  // loop until we've ran out of simulated time
+  for (double time = 0.0; time < max_duration; time += dt) {
+    // update controller state from plant state and execute a single step
+    double current_speed, current_heading;
+    p->getState(current_speed, current_heading);
+    c->setState(current_speed, current_heading);
+    c->step(dt);
+
+    // apply the latest command to our plant
+    double throttle, steering;
+    c->getCommand(throttle, steering);
+    p->command(throttle, steering, dt);
+
+    // check whether or not we're within desired tolerance
+    p->getState(current_speed, current_heading);
+    if (std::abs(current_speed - desired_speed) < speed_tolerance
+        && std::abs(current_heading - desired_heading) < heading_tolerance) {
+      if (++success_count >= CONTROL_FREQUENCY)
+        return true;
+    } else {
+      // reset success count
+      success_count = 0;
+    }
   }
 
   // if we've gotten this far, we've failed
@@ -149,6 +210,38 @@ TEST_F(AckermannControllerTest, System_FakeSetup) {
   EXPECT_NEAR(heading_out, 0.16, 0.01);
 }
 
+/* @brief Test the Mock Plant's actuator lags and RK4 integration. */
+TEST_F(AckermannControllerTest, System_FakeDynamics) {
+  opts_->throttle_time_constant = 0.2;
+  opts_->steering_time_constant = 0.1;
+  opts_->substeps = 4;
+  SetUp();
+
+  // the speed follows a first order lag (velocity_max 10 m/s)
+  double speed, heading, steering;
+  plant_->command(0.5, 0.3, 0.1);
+  plant_->getState(speed, heading);
+  plant_->getSteering(steering);
+  EXPECT_NEAR(speed, 5.0 * (1 - std::exp(-0.1 / 0.2)), 1e-5);
+  EXPECT_NEAR(steering, 0.3 * (1 - std::exp(-0.1 / 0.1)), 1e-5);
+  EXPECT_GT(heading, 0.0);
+
+  // large time steps remain accurate: compare against a fine reference
+  auto simulate = [this](const double dt, const unsigned int substeps) {
+    opts_->substeps = substeps;
+    fake::Plant plant(*opts_, params_);
+    const unsigned int steps = std::lround(2.0 / dt);
+    for (unsigned int i = 0; i != steps; ++i)
+      plant.command(0.8, i * dt < 1.0 ? 0.4 : -0.2, dt);
+    double speed, heading;
+    plant.getState(speed, heading);
+    return heading;
+  };
+  const double reference = simulate(0.001, 4);
+  EXPECT_NEAR(simulate(0.1, 8), reference, 1e-3);
+  EXPECT_NEAR(simulate(0.5, 40), reference, 1e-3);
+}
+
 /* @brief Test that the system converges to a desired setpoint
  * w/ a zero noise Mock Plant.
  */
@@ -175,3 +268,33 @@ TEST_F(AckermannControllerTest, System_NoConvergence) {
   SetUp();
   EXPECT_FALSE(control_loop(plant_, controller_, 100.0, 135.0, 5.0));
 }
+
+/* @brief Test that the system converges to a desired setpoint in lockstep
+ * w/ a zero noise Mock Plant.
+ */
+TEST_F(AckermannControllerTest, System_LockstepConvergence) {
+  EXPECT_TRUE(lockstep_loop(plant_, controller_, 3.0, 1.2, 20.0));
+  EXPECT_FALSE(controller_->isRunning());
+}
+
+/* @brief Test that the system converges in lockstep to a Mock Plant with
+ * actuator lags.
+ */
+TEST_F(AckermannControllerTest, System_LockstepConvergenceLagged) {
+  opts_->throttle_time_constant = 0.1;
+  opts_->steering_time_constant = 0.05;
+  opts_->substeps = 2;
+  SetUp();
+  EXPECT_TRUE(lockstep_loop(plant_, controller_, 3.0, 1.2, 20.0));
+}
+
+/* @brief Test that the system fails to converge in lockstep to a "broken"
+ * Mock Plant.
+ */
+TEST_F(AckermannControllerTest, System_LockstepNoConvergence) {
+  // set noise and reset test fixture
+  opts_->noise_mean = 100.0;
+  opts_->noise_stddev = 0.05;
+  SetUp();
+  EXPECT_FALSE(lockstep_loop(plant_, controller_, 100.0, 135.0, 20.0));
+}
@@ -0,0 +1,99 @@
+/* @file Angle.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+#include <Angle.hpp>
+
+using ackermann::wrapAngle;
+
+/* @brief Test wrapping of finite angles. */
+TEST(Angle_Wrap, should_pass) {
+  // values within range are unchanged
+  for (double a : {0.0, -0.0, 0.5, -3.0, 3.14159, -M_PI})
+    EXPECT_EQ(wrapAngle(a), a);
+
+  // the range is half open
+  EXPECT_DOUBLE_EQ(wrapAngle(M_PI), -M_PI);
+  EXPECT_DOUBLE_EQ(wrapAngle(-M_PI), -M_PI);
+
+  // whole turns are removed
+  EXPECT_NEAR(wrapAngle(3*M_PI/2), -M_PI/2, 1e-12);
+  EXPECT_NEAR(wrapAngle(-5*M_PI/2), -M_PI/2, 1e-12);
+  EXPECT_NEAR(wrapAngle(0.5 + 2000*M_PI), 0.5, 1e-10);
+  EXPECT_NEAR(wrapAngle(-0.5 - 2e6*M_PI), -0.5, 1e-8);
+
+  // large angles (e.g. corrupt sensor values) are still wrapped into range
+  for (double a : {1e9, -1e9, 123456789012.0, 1e14}) {
+    const double w = wrapAngle(a);
+    EXPECT_GE(w, -M_PI);
+    EXPECT_LT(w, M_PI);
+    EXPECT_NEAR(std::remainder(a - w, 2*M_PI), 0.0, 1e-6 * std::abs(a));
+  }
+}
+
+/* @brief Test the rules for non-finite and unrepresentable angles. */
+TEST(Angle_NonFinite, should_pass) {
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_TRUE(std::isnan(wrapAngle(std::nan(""))));
+  EXPECT_TRUE(std::isnan(wrapAngle(inf)));
+  EXPECT_TRUE(std::isnan(wrapAngle(-inf)));
+  EXPECT_TRUE(std::isnan(wrapAngle(ackermann::kMaxWrapAngle)));
+  EXPECT_TRUE(std::isnan(wrapAngle(-1e300)));
+  EXPECT_FALSE(std::isnan(wrapAngle(ackermann::kMaxWrapAngle / 2)));
+}
+
+/* @brief Test wrapping in single precision. */
+TEST(Angle_WrapFloat, should_pass) {
+  const float pi = static_cast<float>(M_PI);
+  for (float a : {0.0f, 0.5f, -3.0f, -pi})
+    EXPECT_EQ(wrapAngle(a), a);
+
+  // float(pi) exceeds pi, so it (and anything rounding to it) is wrapped
+  EXPECT_EQ(wrapAngle(pi), -pi);
+  EXPECT_EQ(wrapAngle(static_cast<float>(-M_PI - 1e-7)), wrapAngle(pi));
+  EXPECT_NEAR(wrapAngle(3 * pi / 2), -pi / 2, 1e-6f);
+  EXPECT_NEAR(wrapAngle(0.5f + 200 * pi), 0.5f, 1e-4f);
+
+  // every float around both boundaries lands within [-pi, pi)
+  for (float a = -pi - 1e-5f; a < -pi + 1e-5f; a = std::nextafter(a, 0.0f)) {
+    EXPECT_GE(wrapAngle(a), -pi);
+    EXPECT_LT(wrapAngle(a), pi);
+    EXPECT_GE(wrapAngle(-a), -pi);
+    EXPECT_LT(wrapAngle(-a), pi);
+  }
+
+  EXPECT_TRUE(std::isnan(wrapAngle(std::numeric_limits<float>::infinity())));
+  EXPECT_TRUE(std::isnan(wrapAngle(ackermann::kMaxWrapAngleFloat)));
+  EXPECT_FALSE(std::isnan(wrapAngle(ackermann::kMaxWrapAngleFloat / 2)));
+}
+
+/* @brief Test that the batch variant matches the scalar one exactly. */
+TEST(Angle_WrapBatch, should_pass) {
+  std::vector<double> angles;
+  for (int i = -1000; i <= 1000; ++i)
+    angles.push_back(i * 0.37 * M_PI);
+  angles.push_back(M_PI);
+  angles.push_back(std::nan(""));
+  angles.push_back(std::numeric_limits<double>::infinity());
+  angles.push_back(1e20);
+
+  std::vector<double> wrapped(angles.size());
+  ackermann::wrapAngles(angles.data(), wrapped.data(), angles.size());
+  for (std::size_t i = 0; i != angles.size(); ++i) {
+    const double expected = wrapAngle(angles[i]);
+    if (std::isnan(expected))
+      EXPECT_TRUE(std::isnan(wrapped[i]));
+    else
+      EXPECT_EQ(wrapped[i], expected);
+  }
+
+  // in place
+  ackermann::wrapAngles(angles.data(), angles.data(), angles.size());
+  for (std::size_t i = 0; i != angles.size() - 3; ++i)
+    EXPECT_EQ(angles[i], wrapped[i]);
+}
@@ -0,0 +1,142 @@
+/* @file CommandHistory.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+
+#include <CommandHistory.hpp>
+#include <Controller.hpp>
+
+using ackermann::Clock;
+using ackermann::CommandHistory;
+using ackermann::StateSample;
+using std::chrono::milliseconds;
+
+namespace {
+
+const Clock::time_point t0 = Clock::time_point() + std::chrono::hours(1);
+
+}  // namespace
+
+/* @brief Test rolling a late measurement forward through the history. */
+TEST(CommandHistory_Predict, should_pass) {
+  CommandHistory history;
+  const StateSample measured {1.0, 0.5, t0 + milliseconds(25)};
+
+  // nothing to replay
+  StateSample predicted = history.predict(measured, t0 + milliseconds(50));
+  EXPECT_EQ(predicted.speed, 1.0);
+  EXPECT_EQ(predicted.heading, 0.5);
+
+  // 10ms commands: speed 1m/s turning at 1rad/s, then 2m/s at -2rad/s
+  for (int i = 0; i != 3; ++i)
+    history.push(t0 + milliseconds(10 * i), 0.01, 1.0, 1.0);
+  for (int i = 3; i != 5; ++i)
+    history.push(t0 + milliseconds(10 * i), 0.01, 2.0, -2.0);
+  EXPECT_EQ(history.size(), 5u);
+
+  // 5ms of the first, then 20ms of the second
+  predicted = history.predict(measured, t0 + milliseconds(50));
+  EXPECT_NEAR(predicted.heading, 0.5 + 0.005 - 0.04, 1e-9);
+  EXPECT_NEAR(predicted.speed, 2.0, 1e-9);
+  EXPECT_EQ(predicted.stamp, measured.stamp);
+
+  // only as far as requested
+  predicted = history.predict(measured, t0 + milliseconds(35));
+  EXPECT_NEAR(predicted.heading, 0.5 + 0.005 - 0.01, 1e-9);
+
+  // measurements from the future are left alone
+  predicted = history.predict(measured, t0 + milliseconds(20));
+  EXPECT_EQ(predicted.heading, 0.5);
+
+  history.clear();
+  EXPECT_EQ(history.size(), 0u);
+}
+
+/* @brief Test that the oldest commands are replaced once full. */
+TEST(CommandHistory_Capacity, should_pass) {
+  CommandHistory history;
+  const std::size_t count = 2 * CommandHistory::kCapacity;
+  for (std::size_t i = 0; i != count; ++i)
+    history.push(t0 + milliseconds(10 * i), 0.01, 1.0, 1.0);
+  EXPECT_EQ(history.size(), CommandHistory::kCapacity);
+
+  // a measurement older than the history is compensated for what's known
+  const Clock::time_point now = t0 + milliseconds(10 * count);
+  const StateSample predicted = history.predict({1.0, 0.0, t0}, now);
+  EXPECT_NEAR(predicted.heading,
+              ackermann::wrapAngle(0.01 * CommandHistory::kCapacity), 1e-9);
+  EXPECT_EQ(predicted.speed, 1.0);
+}
+
+/* @brief Test that a late measurement is rolled forward to the tick time,
+ * so that it matches the controller's own (noise free) prediction. */
+TEST(CommandHistory_Controller, should_pass) {
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  for (const bool compensate : {false, true}) {
+    ackermann::Controller controller(params,
+                                    ackermann::kDefaultTelemetryCapacity);
+    controller.setLatencyCompensation(compensate);
+    controller.setGoal(1.0, 1.0);
+
+    // run open loop, remembering the state 50ms before the final tick
+    StateSample late, expected;
+    for (int i = 0; i != 100; ++i) {
+      const Clock::time_point now = t0 + milliseconds(10 * i);
+      controller.step(0.01, now);
+      if (i == 94) {
+        controller.getState(late);
+        late.stamp = now + milliseconds(10);
+      }
+    }
+    controller.getState(expected);
+
+    // deliver the late measurement; the final tick consumes the prediction
+    EXPECT_TRUE(controller.setState(late));
+    controller.step(0.01, t0 + milliseconds(1000));
+    ackermann::TelemetryRecord record;
+    std::size_t count = 0;
+    while (controller.drainTelemetry(&record, 1))
+      ++count;
+    ASSERT_EQ(count, 101u);
+    const StateSample consumed = record.state;
+
+    if (compensate) {
+      EXPECT_NEAR(consumed.heading, expected.heading, 1e-9);
+      EXPECT_NEAR(consumed.speed, expected.speed, 1e-9);
+    } else {
+      EXPECT_EQ(consumed.heading, late.heading);
+    }
+    EXPECT_NE(late.heading, expected.heading);
+  }
+}
+
+/* @brief Test that reset() forgets the commands applied before it, so that
+ * a measurement taken afterwards isn't rolled forward through them. */
+TEST(CommandHistory_Reset, should_pass) {
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  ackermann::Controller controller(params,
+                                    ackermann::kDefaultTelemetryCapacity);
+  controller.setLatencyCompensation(true);
+  controller.setGoal(1.0, 1.0);
+  for (int i = 0; i != 10; ++i)
+    controller.step(0.01, t0 + milliseconds(10 * i));
+  controller.reset();
+
+  // a measurement older than the final tick is used as is
+  const StateSample measured {0.2, 0.1, t0 + milliseconds(50)};
+  EXPECT_TRUE(controller.setState(measured));
+  controller.step(0.01, t0 + milliseconds(100));
+  ackermann::TelemetryRecord record;
+  std::size_t count = 0;
+  while (controller.drainTelemetry(&record, 1))
+    ++count;
+  ASSERT_EQ(count, 11u);
+  EXPECT_EQ(record.state.speed, measured.speed);
+  EXPECT_EQ(record.state.heading, measured.heading);
+}
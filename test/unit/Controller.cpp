@@ -3,11 +3,154 @@
  */
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <chrono>
 #include <cmath>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
 #include <Controller.hpp>
 #include <Params.hpp>
 
+namespace {
+
+/**
+* @brief Number of allocations made by threads counting them.
+*/
+std::atomic<uint64_t> counted_allocations {0};
+thread_local bool count_allocations = false;
+
+}  // namespace
+
+// count allocations (of threads which opt in) throughout the test program;
+// every form of operator new is replaced, each paired with the matching
+// operator delete (all backed by malloc and free)
+namespace {
+
+void* allocate(const std::size_t size) noexcept {
+  if (count_allocations)
+    counted_allocations.fetch_add(1);
+  return std::malloc(size ? size : 1);
+}
+
+void* allocateOrThrow(const std::size_t size) {
+  if (void* p = allocate(size))
+    return p;
+  throw std::bad_alloc();
+}
+
+#ifdef __cpp_aligned_new
+void* allocate(const std::size_t size, std::align_val_t alignment) noexcept {
+  if (count_allocations)
+    counted_allocations.fetch_add(1);
+  void* p = nullptr;
+  const std::size_t align = static_cast<std::size_t>(alignment);
+  if (posix_memalign(&p, align < sizeof(void*) ? sizeof(void*) : align,
+                     size ? size : 1))
+    return nullptr;
+  return p;
+}
+
+void* allocateOrThrow(const std::size_t size, std::align_val_t alignment) {
+  if (void* p = allocate(size, alignment))
+    return p;
+  throw std::bad_alloc();
+}
+#endif
+
+}  // namespace
+
+void* operator new(std::size_t size) {
+  return allocateOrThrow(size);
+}
+
+void* operator new[](std::size_t size) {
+  return allocateOrThrow(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  return allocate(size);
+}
+
+#ifdef __cpp_aligned_new
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  return allocateOrThrow(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return allocateOrThrow(size, alignment);
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment,
+                   const std::nothrow_t&) noexcept {
+  return allocate(size, alignment);
+}
+
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return allocate(size, alignment);
+}
+#endif
+
+void operator delete(void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+
+#ifdef __cpp_aligned_new
+void operator delete(void* p, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept {
+  std::free(p);
+}
+
+void operator delete(void* p, std::align_val_t,
+                     const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+
+void operator delete[](void* p, std::align_val_t,
+                       const std::nothrow_t&) noexcept {
+  std::free(p);
+}
+#endif
+
 
 /**
 * @brief Test Fixture for repeated independent construction of the Controller.
@@ -130,3 +273,213 @@ TEST_F(AckemannControllerTest, ControllerThreading) {
     EXPECT_FALSE(controller_->isRunning());
   }
 }
+
+/* @brief Test lockstep execution of the Controller */
+TEST_F(AckemannControllerTest, ControllerLockstep) {
+  // stepping should drive our commands towards the goal
+  {
+    controller_->setGoal(2.0, 0.5);
+    for (unsigned int i = 0; i != 10; ++i)
+      controller_->step(0.01);
+    EXPECT_FALSE(controller_->isRunning());
+
+    double throttle, steering;
+    controller_->getCommand(throttle, steering);
+    EXPECT_GT(throttle, 0.0);
+    EXPECT_GT(steering, 0.0);
+  }
+
+  // two identical controllers should produce bit-identical results
+  {
+    ackermann::Controller other(params_);
+    controller_->reset();
+    for (unsigned int i = 0; i != 1000; ++i) {
+      controller_->setGoal(3.0, -1.2);
+      other.setGoal(3.0, -1.2);
+      controller_->step(0.01);
+      other.step(0.01);
+
+      double throttle, steering, other_throttle, other_steering;
+      controller_->getCommand(throttle, steering);
+      other.getCommand(other_throttle, other_steering);
+      ASSERT_EQ(throttle, other_throttle);
+      ASSERT_EQ(steering, other_steering);
+    }
+  }
+}
+
+/* @brief Test the telemetry produced by each iteration */
+TEST_F(AckemannControllerTest, ControllerTelemetry) {
+  // disabled by default
+  EXPECT_EQ(controller_->getTelemetryCapacity(), 0u);
+  controller_->step(0.01);
+  ackermann::TelemetryRecord record;
+  EXPECT_EQ(controller_->drainTelemetry(&record, 1), 0u);
+  EXPECT_EQ(controller_->getTelemetryDropped(), 0u);
+  EXPECT_THROW(ackermann::Controller(params_, 1000), std::invalid_argument);
+
+  controller_ = std::make_unique<ackermann::Controller>(params_, 64);
+  std::vector<ackermann::TelemetryRecord> records(
+    controller_->getTelemetryCapacity());
+  EXPECT_EQ(records.size(), 64u);
+  EXPECT_EQ(controller_->drainTelemetry(records.data(), records.size()), 0u);
+
+  controller_->setState(1.0, 0.1);
+  controller_->setGoal(2.0, 0.5);
+  for (unsigned int i = 0; i != 5; ++i)
+    controller_->step(0.01);
+
+  // one record per iteration, in order
+  std::size_t count = controller_->drainTelemetry(records.data(),
+                                                  records.size());
+  ASSERT_EQ(count, 5u);
+  for (std::size_t i = 0; i != count; ++i)
+    EXPECT_EQ(records[i].tick, i);
+
+  // the first record reflects our inputs
+  EXPECT_DOUBLE_EQ(records[0].state.speed, 1.0);
+  EXPECT_DOUBLE_EQ(records[0].goal.heading, 0.5);
+  EXPECT_DOUBLE_EQ(records[0].speed_error, 1.0);
+  EXPECT_DOUBLE_EQ(records[0].heading_error, 0.4);
+
+  // the last record matches the current command
+  double throttle, steering;
+  controller_->getCommand(throttle, steering);
+  EXPECT_DOUBLE_EQ(records[4].throttle, throttle);
+  EXPECT_DOUBLE_EQ(records[4].steering, steering);
+
+  // nothing is returned twice, and overflow is counted rather than blocking
+  EXPECT_EQ(controller_->drainTelemetry(records.data(), records.size()), 0u);
+  for (std::size_t i = 0; i != records.size() + 3; ++i)
+    controller_->step(0.01);
+  EXPECT_EQ(controller_->getTelemetryDropped(), 3u);
+  EXPECT_EQ(controller_->drainTelemetry(records.data(), records.size()),
+            records.size());
+
+  // simulated iterations are stamped with the simulated time
+  const ackermann::Clock::time_point now{std::chrono::seconds(5)};
+  controller_->step(0.01, now);
+  ASSERT_EQ(controller_->drainTelemetry(records.data(), 1), 1u);
+  EXPECT_EQ(records[0].stamp, now);
+  ackermann::CommandSample command;
+  controller_->getCommand(command);
+  EXPECT_EQ(command.stamp, now);
+}
+
+/* @brief Test command subscription and waiting */
+TEST_F(AckemannControllerTest, ControllerCommandEvents) {
+  using ackermann::CommandSample;
+
+  // no command has been produced yet
+  CommandSample command;
+  controller_->getCommand(command);
+  EXPECT_EQ(command.sequence, 0u);
+  EXPECT_FALSE(controller_->waitForCommand(0, command,
+                                           std::chrono::milliseconds(1)));
+
+  // subscribers see every command, in order
+  std::vector<CommandSample> seen;
+  const std::size_t id = controller_->subscribe(
+    [&seen](const CommandSample& c) { seen.push_back(c); });
+  controller_->setGoal(2.0, 0.5);
+  for (unsigned int i = 0; i != 3; ++i)
+    controller_->step(0.01);
+  ASSERT_EQ(seen.size(), 3u);
+  for (std::size_t i = 0; i != seen.size(); ++i)
+    EXPECT_EQ(seen[i].sequence, i + 1);
+
+  // which match the latest command
+  double throttle, steering;
+  controller_->getCommand(throttle, steering);
+  controller_->getCommand(command);
+  EXPECT_EQ(command.sequence, 3u);
+  EXPECT_DOUBLE_EQ(command.throttle, throttle);
+  EXPECT_DOUBLE_EQ(command.steering, steering);
+  EXPECT_DOUBLE_EQ(seen.back().throttle, throttle);
+  EXPECT_DOUBLE_EQ(seen.back().steering, steering);
+
+  // an already available command is returned immediately
+  EXPECT_TRUE(controller_->waitForCommand(2, command, ackermann::Clock::duration(0)));
+  EXPECT_EQ(command.sequence, 3u);
+
+  controller_->unsubscribe(id);
+  controller_->step(0.01);
+  EXPECT_EQ(seen.size(), 3u);
+
+  // clients are woken by the running control loop
+  controller_->start();
+  uint64_t last = 4;
+  for (unsigned int i = 0; i != 5; ++i) {
+    ASSERT_TRUE(controller_->waitForCommand(last, command,
+                                            std::chrono::seconds(1)));
+    EXPECT_GT(command.sequence, last);
+    last = command.sequence;
+  }
+  controller_->stop(true);
+}
+
+namespace {
+
+// run the given controller's loop, returning the allocations it made (from
+// its first command)
+uint64_t loopAllocations(ackermann::Controller& controller,
+                         ackermann::Params& params) {
+  std::atomic<uint64_t> commands {0};
+  controller.subscribe([&commands](const ackermann::CommandSample&) {
+    count_allocations = true;
+    commands.fetch_add(1);
+  });
+  const uint64_t allocations = counted_allocations;
+
+  params.control_frequency = 1000;
+  controller.start();
+  for (unsigned int i = 0; i != 200; ++i) {
+    controller.setState(0.01 * i, 0.0);
+    controller.setGoal(1.0, 0.5);
+    std::this_thread::sleep_for(std::chrono::microseconds(500));
+  }
+  controller.stop(true);
+  EXPECT_GT(commands, 10u);
+  return counted_allocations - allocations;
+}
+
+}  // namespace
+
+/* @brief Test the running control loop never allocates. */
+TEST_F(AckemannControllerTest, ControllerAllocationFree) {
+  EXPECT_EQ(loopAllocations(*controller_, *params_), 0u);
+}
+
+/* @brief Test the loop of a ControllerBlock never allocates, and has no
+ * reference count to modify: every shared_ptr held by the controller (and
+ * its components) aliases the block without a control block. */
+TEST(ControllerBlock_AllocationFree, should_pass) {
+  auto block = std::make_unique<ackermann::ControllerBlock>(0.45, 0.45, 0.785,
+                                                            1.0, 1.0);
+  EXPECT_EQ(block->params.pid_speed.use_count(), 0);
+  EXPECT_EQ(block->params.pid_heading.use_count(), 0);
+  EXPECT_EQ(loopAllocations(block->controller, block->params), 0u);
+}
+
+/* @brief Test constructing a controller in a single allocation. */
+TEST(ControllerBlock, should_pass) {
+  count_allocations = true;
+  const uint64_t allocations = counted_allocations;
+  auto block = std::make_unique<ackermann::ControllerBlock>(0.45, 0.45, 0.785,
+                                                            1.0, 1.0);
+  EXPECT_EQ(counted_allocations - allocations, 1u);
+  count_allocations = false;
+
+  // the parameters live in the block, and are used by the controller
+  EXPECT_EQ(block->params.pid_speed.get(), &block->pid_speed);
+  EXPECT_EQ(block->params.pid_speed.use_count(), 0);
+  block->params.update([](ackermann::Params& p) {
+    p.max_steering_angle = 0.1;
+  });
+  block->controller.setGoal(1.0, 1.0);
+  block->controller.step(0.01);
+  double throttle, steering;
+  block->controller.getCommand(throttle, steering);
+  EXPECT_GT(throttle, 0.0);
+  EXPECT_DOUBLE_EQ(steering, 0.1);
+}
@@ -0,0 +1,140 @@
+/* @file Executor.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <Controller.hpp>
+#include <Executor.hpp>
+#include <Params.hpp>
+
+using ackermann::Controller;
+using ackermann::Executor;
+
+/* @brief Test that many controllers run at their own frequencies on a few
+ * workers. */
+TEST(Executor_Frequencies, should_pass) {
+  auto executor = std::make_shared<Executor>(2);
+  EXPECT_EQ(executor->workers(), 2u);
+
+  // half of the controllers at 100Hz, the rest at 50Hz
+  std::vector<std::shared_ptr<ackermann::Params>> params;
+  std::vector<std::unique_ptr<Controller>> controllers;
+  for (std::size_t i = 0; i != 20; ++i) {
+    params.push_back(std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                         1.0, 1.0));
+    params.back()->control_frequency = i % 2 ? 50.0 : 100.0;
+    controllers.push_back(std::make_unique<Controller>(params.back()));
+    controllers.back()->setExecutor(executor);
+    controllers.back()->setGoal(1.0, 0.5);
+    controllers.back()->start();
+    EXPECT_TRUE(controllers.back()->isRunning());
+  }
+  EXPECT_EQ(executor->size(), controllers.size());
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(500));
+  for (auto& controller : controllers)
+    controller->stop(true);
+  EXPECT_EQ(executor->size(), 0u);
+
+  for (std::size_t i = 0; i != controllers.size(); ++i) {
+    EXPECT_FALSE(controllers[i]->isRunning());
+    const auto stats = controllers[i]->getTimingStats();
+    const double expected = (i % 2 ? 50.0 : 100.0) * 0.5;
+    EXPECT_GT(stats.iterations + stats.missed_ticks, 0.8 * expected);
+    EXPECT_LT(stats.iterations, 1.2 * expected + 1);
+
+    // every controller was executed
+    double throttle, steering;
+    controllers[i]->getCommand(throttle, steering);
+    EXPECT_GT(throttle, 0.0);
+  }
+}
+
+/* @brief Test that overruns are reported for the offending controller only. */
+TEST(Executor_MissedDeadlines, should_pass) {
+  auto executor = std::make_shared<Executor>(2);
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  Controller slow(params), fast(params);
+  slow.subscribe([](const ackermann::CommandSample&){
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+  });
+  slow.setExecutor(executor);
+  fast.setExecutor(executor);
+  slow.start();
+  fast.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  slow.stop(true);
+  fast.stop(true);
+
+  EXPECT_GT(slow.getTimingStats().overruns, 0u);
+  EXPECT_GT(slow.getTimingStats().missed_ticks, 0u);
+  EXPECT_GT(fast.getTimingStats().iterations, 20u);
+}
+
+/* @brief Test that a controller can be restarted, and moved between an
+ * executor and its own thread. */
+TEST(Executor_Restart, should_pass) {
+  auto executor = std::make_shared<Executor>();
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  Controller controller(params);
+  controller.setExecutor(executor);
+  for (std::size_t i = 0; i != 3; ++i) {
+    controller.start();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    controller.stop();
+  }
+  controller.stop(true);
+  EXPECT_FALSE(controller.isRunning());
+  EXPECT_EQ(executor->size(), 0u);
+
+  // standalone again
+  controller.setExecutor(nullptr);
+  controller.start();
+  EXPECT_EQ(executor->size(), 0u);
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  controller.stop(true);
+  EXPECT_GT(controller.getTimingStats().iterations, 0u);
+}
+
+/* @brief Test that restarting some controllers repeatedly doesn't disturb
+ * the others' schedules. */
+TEST(Executor_Churn, should_pass) {
+  auto executor = std::make_shared<Executor>(3);
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  Controller steady(params);
+  steady.setExecutor(executor);
+  steady.start();
+
+  std::vector<std::unique_ptr<Controller>> churning;
+  for (std::size_t i = 0; i != 4; ++i) {
+    churning.push_back(std::make_unique<Controller>(params));
+    churning.back()->setExecutor(executor);
+  }
+  const auto start = std::chrono::steady_clock::now();
+  while (std::chrono::steady_clock::now() - start
+         < std::chrono::milliseconds(300)) {
+    for (auto& controller : churning)
+      controller->start();
+    EXPECT_EQ(executor->size(), churning.size() + 1);
+    for (auto& controller : churning)
+      controller->stop();
+  }
+  for (auto& controller : churning)
+    controller->stop(true);
+  EXPECT_EQ(executor->size(), 1u);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  steady.stop(true);
+  EXPECT_EQ(executor->size(), 0u);
+  const auto stats = steady.getTimingStats();
+  EXPECT_GT(stats.iterations + stats.missed_ticks, 0.8 * 40);
+  EXPECT_LT(stats.iterations, 1.2 * 40 + 1);
+}
@@ -0,0 +1,116 @@
+/* @file FleetController.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+#include <Controller.hpp>
+#include <FleetController.hpp>
+#include <Params.hpp>
+
+/**
+* @brief Test Fixture for comparing a fleet against individual Controllers.
+*/
+class AckermannFleetTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    params_ = std::make_shared<ackermann::Params>(0.45, 0.45, 0.785, 1.0, 1.0);
+    params_->pid_speed->ki = 0.5;
+    params_->pid_speed->kd = 0.01;
+    params_->pid_heading->ki = 0.5;
+    params_->pid_heading->kd = 0.01;
+  }
+
+  /* @brief Step a fleet and equivalent Controllers; compare results. */
+  void compare(const std::size_t size, const unsigned int steps) {
+    ackermann::FleetController fleet(params_, size);
+    std::vector<std::unique_ptr<ackermann::Controller>> controllers;
+
+    for (std::size_t i = 0; i != size; ++i) {
+      // pick some arbitrary (but varied) states and goals
+      double speed = 0.5 * (i % 7);
+      double heading = -3.0 + 0.37 * i;
+      double goal_speed = 12.0 - 0.9 * (i % 13);
+      double goal_heading = 2.5 - 0.61 * i;
+
+      controllers.push_back(std::make_unique<ackermann::Controller>(params_));
+      controllers.back()->setState(speed, heading);
+      controllers.back()->setGoal(goal_speed, goal_heading);
+      fleet.setState(i, speed, heading);
+      fleet.setGoal(i, goal_speed, goal_heading);
+    }
+
+    std::vector<double> lf(size), rf(size), lr(size), rr(size);
+    for (unsigned int s = 0; s != steps; ++s) {
+      fleet.step(0.01);
+      fleet.getWheelLinVels(lf.data(), rf.data(), lr.data(), rr.data());
+      for (std::size_t i = 0; i != size; ++i) {
+        controllers[i]->step(0.01);
+
+        double throttle, steering, fleet_throttle, fleet_steering;
+        controllers[i]->getCommand(throttle, steering);
+        fleet.getCommand(i, fleet_throttle, fleet_steering);
+        ASSERT_DOUBLE_EQ(throttle, fleet_throttle);
+        ASSERT_DOUBLE_EQ(steering, fleet_steering);
+
+        double speed, heading, fleet_speed, fleet_heading;
+        controllers[i]->getState(speed, heading);
+        fleet.getState(i, fleet_speed, fleet_heading);
+        ASSERT_DOUBLE_EQ(speed, fleet_speed);
+        ASSERT_DOUBLE_EQ(heading, fleet_heading);
+
+        double wheel_lf, wheel_rf, wheel_lr, wheel_rr;
+        controllers[i]->getWheelLinVel(wheel_lf, wheel_rf, wheel_lr, wheel_rr);
+        ASSERT_DOUBLE_EQ(wheel_lf, lf[i]);
+        ASSERT_DOUBLE_EQ(wheel_rf, rf[i]);
+        ASSERT_DOUBLE_EQ(wheel_lr, lr[i]);
+        ASSERT_DOUBLE_EQ(wheel_rr, rr[i]);
+      }
+    }
+  }
+
+  std::shared_ptr<ackermann::Params> params_;
+};
+
+/* @brief Test fleet setters and getters */
+TEST_F(AckermannFleetTest, Fleet_SettersAndGetters) {
+  ackermann::FleetController fleet(params_, 3);
+  EXPECT_EQ(fleet.size(), 3u);
+
+  std::vector<double> speeds {1.0, 2.0, 3.0};
+  std::vector<double> headings {0.1, -0.2, 3*M_PI/2};
+  fleet.setStates(speeds.data(), headings.data());
+  fleet.setGoals(speeds.data(), headings.data());
+
+  double speed, heading;
+  fleet.getState(1, speed, heading);
+  EXPECT_DOUBLE_EQ(speed, 2.0);
+  EXPECT_DOUBLE_EQ(heading, -0.2);
+  fleet.getGoal(2, speed, heading);
+  EXPECT_DOUBLE_EQ(speed, 3.0);
+  EXPECT_DOUBLE_EQ(heading, -M_PI/2);
+
+  fleet.reset();
+  fleet.getState(1, speed, heading);
+  EXPECT_DOUBLE_EQ(speed, 0.0);
+  EXPECT_DOUBLE_EQ(heading, 0.0);
+}
+
+/* @brief Test that the fleet matches individual controllers (no limits) */
+TEST_F(AckermannFleetTest, Fleet_MatchesController) {
+  compare(37, 300);
+}
+
+/* @brief Test that the fleet matches individual controllers (saturated) */
+TEST_F(AckermannFleetTest, Fleet_MatchesControllerLimited) {
+  params_->acceleration_max = 2.0;
+  params_->acceleration_min = -3.0;
+  params_->angular_velocity_max = 0.5;
+  params_->angular_velocity_min = -0.4;
+  params_->angular_acceleration_max = 4.0;
+  params_->angular_acceleration_min = -5.0;
+  compare(37, 300);
+}
@@ -0,0 +1,177 @@
+/* @file FlightRecorder.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdio>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include <Controller.hpp>
+#include <FlightRecorder.hpp>
+#include <Replay.hpp>
+
+using ackermann::FlightLog;
+using ackermann::FlightRecord;
+using ackermann::FlightRecorder;
+
+namespace {
+
+std::string recordingPath(const std::string& name) {
+  return ::testing::internal::TempDir() + name + "."
+    + std::to_string(::getpid()) + ".flight";
+}
+
+}  // namespace
+
+/* @brief Test writing and reading back each kind of event. */
+TEST(FlightRecorder_Events, should_pass) {
+  const std::string path = recordingPath("events");
+  {
+    FlightRecorder recorder(path, 4);
+    recorder.recordState({1.0, 0.5, ackermann::Clock::now()});
+    recorder.recordGoal({2.0, -0.5, ackermann::Clock::now()});
+    recorder.recordReset();
+    ackermann::TelemetryRecord tick;
+    tick.tick = 7;
+    tick.throttle = 0.25;
+    recorder.recordTick(tick, 0.01);
+    // beyond our capacity
+    recorder.recordReset();
+    EXPECT_EQ(recorder.size(), 4u);
+    EXPECT_EQ(recorder.dropped(), 1u);
+  }
+
+  FlightLog log(path);
+  ASSERT_EQ(log.size(), 4u);
+  EXPECT_EQ(log[0].type, FlightRecord::State);
+  EXPECT_DOUBLE_EQ(log[0].get<ackermann::StateSample>().heading, 0.5);
+  EXPECT_EQ(log[1].type, FlightRecord::Goal);
+  EXPECT_DOUBLE_EQ(log[1].get<ackermann::GoalSample>().speed, 2.0);
+  EXPECT_EQ(log[2].type, FlightRecord::Reset);
+  EXPECT_EQ(log[3].type, FlightRecord::Tick);
+  EXPECT_DOUBLE_EQ(log[3].dt, 0.01);
+  EXPECT_EQ(log[3].get<ackermann::TelemetryRecord>().tick, 7u);
+  EXPECT_DOUBLE_EQ(log[3].get<ackermann::TelemetryRecord>().throttle, 0.25);
+  ::unlink(path.c_str());
+}
+
+/* @brief Test that invalid files are rejected. */
+TEST(FlightRecorder_Invalid, should_pass) {
+  EXPECT_THROW(FlightLog("/nonexistent/recording"), std::system_error);
+  EXPECT_THROW(FlightRecorder("/nonexistent/recording", 1),
+               std::system_error);
+  EXPECT_THROW(FlightLog("/proc/self/cmdline"), std::runtime_error);
+}
+
+/* @brief Test that a recorded asynchronous run replays without divergence. */
+TEST(FlightRecorder_Replay, should_pass) {
+  const std::string path = recordingPath("replay");
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  params->pid_speed->ki = 0.5;
+  params->pid_heading->kd = 0.1;
+  uint64_t recorded_ticks = 0;
+  {
+    auto recorder = std::make_shared<FlightRecorder>(path, 100000);
+    ackermann::Controller controller(params);
+    controller.setRecorder(recorder);
+
+    // drive the real time loop with changing inputs and parameters
+    controller.setGoal(2.0, 0.5);
+    controller.start();
+    for (unsigned int i = 0; i != 30; ++i) {
+      controller.setState(0.05 * i, 0.01 * i);
+      if (i == 15)
+        params->update([](ackermann::Params& p) {p.pid_speed->kp = 2.0;});
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    controller.stop(true);
+    recorded_ticks = controller.getTimingStats().iterations;
+    EXPECT_EQ(recorder->dropped(), 0u);
+  }
+
+  FlightLog log(path);
+  const ackermann::ReplayResult result = ackermann::replay(log);
+  EXPECT_GT(result.ticks, 0u);
+  EXPECT_EQ(result.ticks, recorded_ticks);
+  EXPECT_EQ(result.inputs, 31u);
+  EXPECT_EQ(result.divergent_ticks, 0u);
+  EXPECT_EQ(result.max_error, 0.0);
+  ::unlink(path.c_str());
+}
+
+/* @brief Test that a trajectory followed with feed-forward replays without
+ * divergence. */
+TEST(FlightRecorder_ReplayFeedForward, should_pass) {
+  const std::string path = recordingPath("feedforward");
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  const ackermann::Clock::time_point t0 {std::chrono::seconds(10)};
+  {
+    auto recorder = std::make_shared<FlightRecorder>(path, 1000);
+    ackermann::Controller controller(params);
+    controller.setRecorder(recorder);
+    controller.setFeedForward(true);
+
+    // accelerate and turn at a constant rate
+    for (int i = 0; i <= 3; ++i)
+      ASSERT_TRUE(controller.appendTrajectory(
+        {0.5 + 0.1 * i, 0.2 * i, t0 + std::chrono::milliseconds(1000 * i)}));
+    for (int i = 0; i != 300; ++i)
+      controller.step(0.01, t0 + std::chrono::milliseconds(10 * i));
+  }
+
+  FlightLog log(path);
+  const ackermann::ReplayResult result = ackermann::replay(log);
+  EXPECT_EQ(result.ticks, 300u);
+  EXPECT_EQ(result.divergent_ticks, 0u);
+  EXPECT_EQ(result.max_error, 0.0);
+  ::unlink(path.c_str());
+}
+
+/* @brief Test that replay detects a changed pipeline. */
+TEST(FlightRecorder_Divergence, should_pass) {
+  const std::string path = recordingPath("divergence");
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  {
+    auto recorder = std::make_shared<FlightRecorder>(path, 1000);
+    ackermann::Controller controller(params);
+    controller.setRecorder(recorder);
+    controller.setGoal(2.0, 0.5);
+    for (unsigned int i = 0; i != 100; ++i)
+      controller.step(0.01);
+  }
+
+  // corrupt the final recorded output (the header occupies the first slot)
+  {
+    FlightLog log(path);
+    const std::size_t index = log.size() - 1;
+    ASSERT_EQ(log[index].type, FlightRecord::Tick);
+    auto tick = log[index].get<ackermann::TelemetryRecord>();
+    tick.throttle += 0.5;
+
+    FILE* file = std::fopen(path.c_str(), "r+b");
+    ASSERT_NE(file, nullptr);
+    std::fseek(file, static_cast<long>((index + 1) * sizeof(FlightRecord)
+                                       + offsetof(FlightRecord, payload)),
+               SEEK_SET);
+    std::fwrite(&tick, sizeof(tick), 1, file);
+    std::fclose(file);
+  }
+
+  FlightLog log(path);
+  const ackermann::ReplayResult result = ackermann::replay(log);
+  EXPECT_EQ(result.ticks, 100u);
+  EXPECT_EQ(result.divergent_ticks, 1u);
+  EXPECT_EQ(result.first_divergence, 99u);
+  EXPECT_DOUBLE_EQ(result.max_error, 0.5);
+  ::unlink(path.c_str());
+}
@@ -415,3 +415,36 @@ TEST(ShortestArcToTurn, should_pass) {
     EXPECT_DOUBLE_EQ(arc, -(M_PI-0.1));
   }
 }
+
+/* @brief Test range only constraints, and single precision. */
+TEST(Limits_Policies, should_pass) {
+  const float dt = 0.01f;
+  auto p = std::make_shared<Params>(0.0, 0.0, 1.0, 0.0, 0.0);
+  p->acceleration_max = 1.0;
+  p->angular_velocity_max = 0.1;
+  ackermann::BasicLimits<float> rates(p);
+  ackermann::BasicLimits<float, ackermann::RangeConstraints> ranges(p);
+
+  // rate constraints limit the change from the current command
+  float throttle = 1.0f, steering = 2.0f, steering_vel;
+  rates.limit(0.0f, 0.0f, 0.0f, throttle, steering, steering_vel, dt);
+  EXPECT_FLOAT_EQ(throttle, rates.speedToThrottle(0.01f));
+  EXPECT_FLOAT_EQ(steering, 0.001f);
+  EXPECT_FLOAT_EQ(steering_vel, 0.1f);
+
+  // range constraints don't; only the range is enforced
+  throttle = 2.0f;
+  steering = 2.0f;
+  ranges.limit(0.0f, 0.0f, 0.0f, throttle, steering, steering_vel, dt);
+  EXPECT_FLOAT_EQ(throttle, 1.0f);
+  EXPECT_FLOAT_EQ(steering, 1.0f);
+  EXPECT_FLOAT_EQ(steering_vel, 100.0f);
+
+  EXPECT_NEAR(ranges.shortestArcToTurn(3.0f, -3.0f), 2 * M_PI - 6.0, 1e-6);
+
+  // headings are bound in single precision, strictly below float(pi)
+  const float pi = static_cast<float>(M_PI);
+  EXPECT_EQ(rates.boundHeading(pi), -pi);
+  EXPECT_EQ(rates.boundHeading(static_cast<float>(M_PI - 1e-9)), -pi);
+  EXPECT_LT(rates.boundHeading(std::nextafter(pi, 0.0f)), pi);
+}
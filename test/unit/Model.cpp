@@ -4,8 +4,11 @@
 
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <iostream>
 #include <cmath>
+#include <limits>
+#include <thread>
 
 #include "Model.hpp"
 #include "Limits.hpp"
@@ -262,3 +265,163 @@ TEST_F(AckemannModelTest, WheelSpeedCalc) {
     EXPECT_NEAR(LR, 0, 1E-10);
   }
 }
+
+/* @brief Test the timestamped state and goal interface. */
+TEST_F(AckemannModelTest, Model_Samples) {
+  const auto stamp = ackermann::Clock::now();
+
+  // samples are published as given (with bounded headings)
+  ackermann::StateSample state {2.0, 2*M_PI + 0.5, stamp};
+  model_->setState(state);
+  ackermann::StateSample state_out;
+  model_->getState(state_out);
+  EXPECT_DOUBLE_EQ(state_out.speed, 2.0);
+  EXPECT_NEAR(state_out.heading, 0.5, 1E-10);
+  EXPECT_EQ(state_out.stamp, stamp);
+
+  ackermann::GoalSample goal {3.0, -0.25, stamp};
+  model_->setGoal(goal);
+  ackermann::GoalSample goal_out;
+  model_->getGoal(goal_out);
+  EXPECT_DOUBLE_EQ(goal_out.speed, 3.0);
+  EXPECT_DOUBLE_EQ(goal_out.heading, -0.25);
+  EXPECT_EQ(goal_out.stamp, stamp);
+
+  // the two-double overloads stamp with the current time
+  model_->setState(1.0, 0.1);
+  model_->getState(state_out);
+  EXPECT_GE(state_out.stamp, stamp);
+
+  // model updates retain the timestamp of the underlying measurement
+  model_->setState(state);
+  model_->command(0.1, 0.1, 0.01);
+  model_->getState(state_out);
+  EXPECT_EQ(state_out.stamp, stamp);
+}
+
+/* @brief Test that concurrent readers never observe a torn state. */
+TEST_F(AckemannModelTest, Model_StateConsistency) {
+  std::atomic<bool> done {false};
+
+  // continually publish states where speed and heading match
+  std::thread writer([this, &done]() {
+    for (unsigned int i = 1; i <= 20000; ++i) {
+      double value = (i % 300) / 100.0;
+      model_->setState(value, value);
+    }
+    done = true;
+  });
+
+  unsigned int torn = 0;
+  while (!done) {
+    double speed, heading;
+    model_->getState(speed, heading);
+    if (speed != heading)
+      ++torn;
+  }
+  writer.join();
+
+  EXPECT_EQ(torn, 0u);
+}
+
+/* @brief Test that non-finite inputs are rejected. */
+TEST_F(AckemannModelTest, Model_NonFinite) {
+  EXPECT_TRUE(model_->setState(1.0, 0.5));
+  EXPECT_TRUE(model_->setGoal(2.0, -0.5));
+
+  const double nan = std::nan("");
+  const double inf = std::numeric_limits<double>::infinity();
+  EXPECT_FALSE(model_->setState(nan, 0.0));
+  EXPECT_FALSE(model_->setState(1.0, inf));
+  EXPECT_FALSE(model_->setGoal(-inf, 0.0));
+  EXPECT_FALSE(model_->setGoal(1.0, nan));
+
+  // the previous values are retained
+  double speed, heading;
+  model_->getState(speed, heading);
+  EXPECT_DOUBLE_EQ(speed, 1.0);
+  EXPECT_DOUBLE_EQ(heading, 0.5);
+  model_->getGoal(speed, heading);
+  EXPECT_DOUBLE_EQ(speed, 2.0);
+  EXPECT_DOUBLE_EQ(heading, -0.5);
+
+  // large (but finite) headings are wrapped
+  EXPECT_TRUE(model_->setState(1.0, 1e9));
+  model_->getState(speed, heading);
+  EXPECT_GE(heading, -M_PI);
+  EXPECT_LT(heading, M_PI);
+}
+
+/* @brief Test a single precision model against the default. */
+TEST_F(AckemannModelTest, Model_SinglePrecision) {
+  ackermann::BasicModel<float> single(params_);
+  model_->setState(1.0, 0.5);
+  single.setState(1.0f, 0.5f);
+  for (int i = 0; i != 100; ++i) {
+    const double steering = 0.5 * std::sin(0.1 * i);
+    model_->command(0.3, steering, 0.01);
+    single.command(0.3f, static_cast<float>(steering), 0.01f);
+  }
+
+  double speed, heading;
+  float single_speed, single_heading;
+  model_->getState(speed, heading);
+  single.getState(single_speed, single_heading);
+  EXPECT_NEAR(single_speed, speed, 1e-5);
+  EXPECT_NEAR(single_heading, heading, 1e-5);
+
+  double lf, rf, lr, rr;
+  float single_lf, single_rf, single_lr, single_rr;
+  model_->getWheelLinVel(lf, rf, lr, rr);
+  single.getWheelLinVel(single_lf, single_rf, single_lr, single_rr);
+  EXPECT_NEAR(single_lf, lf, 1e-5);
+  EXPECT_NEAR(single_rr, rr, 1e-5);
+}
+
+/* @brief Test models are cache line aligned, wherever they are allocated. */
+TEST_F(AckemannModelTest, Model_Alignment) {
+  EXPECT_EQ(alignof(ackermann::Model) % 64, 0u);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(model_.get()) % 64, 0u);
+  ackermann::Model local(params_);
+  EXPECT_EQ(reinterpret_cast<uintptr_t>(&local) % 64, 0u);
+}
+
+/* @brief Test that inputs are consumed once by the commanding thread, and
+ * that adopted values hold until a newer input is consumed. */
+TEST_F(AckemannModelTest, Model_Inputs) {
+  ackermann::StateSample state;
+  ackermann::GoalSample goal;
+
+  // a measurement is integrated from, then not consumed again
+  model_->setState(1.0, 0.5);
+  model_->command(0.1, 0.2, 0.1);
+  model_->getInputs(state, goal);
+  const double integrated = state.heading;
+  EXPECT_GT(integrated, 0.5);
+  model_->command(0.1, 0.2, 0.1);
+  model_->getInputs(state, goal);
+  EXPECT_GT(state.heading, integrated);
+  double speed, heading;
+  model_->getState(speed, heading);
+  EXPECT_EQ(heading, state.heading);
+
+  // an adopted setpoint holds until a newer one is consumed
+  EXPECT_TRUE(model_->adoptGoal({2.0, 0.25, ackermann::Clock::now()}));
+  model_->sync();
+  model_->getGoal(speed, heading);
+  EXPECT_EQ(heading, 0.25);
+  EXPECT_TRUE(model_->setGoal(3.0, -0.25));
+  model_->getGoal(speed, heading);
+  EXPECT_EQ(heading, -0.25);
+  model_->getInputs(state, goal);
+  EXPECT_EQ(goal.heading, 0.25);
+  model_->sync();
+  model_->getInputs(state, goal);
+  EXPECT_EQ(goal.heading, -0.25);
+
+  // adopted values are validated as inputs are
+  EXPECT_FALSE(model_->adoptState(
+    {std::numeric_limits<double>::quiet_NaN(), 0.0, ackermann::Clock::now()}));
+  model_->getInputs(state, goal);
+  EXPECT_TRUE(std::isfinite(state.speed));
+}
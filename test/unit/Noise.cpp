@@ -0,0 +1,128 @@
+/* @file Noise.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include <Params.hpp>
+#include <fake/noise.h>
+#include <fake/plant.h>
+
+/* @brief Test that streams are reproducible and independent. */
+TEST(Noise_Streams, should_pass) {
+  fake::Random a(42, 0), b(42, 0), c(42, 1), d(43, 0);
+  for (unsigned int i = 0; i != 1000; ++i) {
+    const uint64_t value = a.next();
+    EXPECT_EQ(value, b.next());
+    EXPECT_NE(value, c.next());
+    EXPECT_NE(value, d.next());
+  }
+
+  // the sequence is fixed (independent of the platform)
+  fake::Random e(0, 0);
+  EXPECT_EQ(e.next(), 0xe220a8397b1dcdafULL);
+}
+
+/* @brief Test the distributions of generated samples. */
+TEST(Noise_Distributions, should_pass) {
+  fake::NoiseSource source(7, 3);
+  const unsigned int n = 200000;
+  double sum = 0.0, sum_sq = 0.0, uniform_sum = 0.0;
+  for (unsigned int i = 0; i != n; ++i) {
+    const double x = source.gaussian();
+    sum += x;
+    sum_sq += x * x;
+    const double u = source.uniform();
+    EXPECT_GE(u, 0.0);
+    EXPECT_LT(u, 1.0);
+    uniform_sum += u;
+  }
+  EXPECT_NEAR(sum / n, 0.0, 0.01);
+  EXPECT_NEAR(sum_sq / n, 1.0, 0.02);
+  EXPECT_NEAR(uniform_sum / n, 0.5, 0.01);
+}
+
+/* @brief Test the individual noise models. */
+TEST(Noise_Models, should_pass) {
+  fake::NoiseSource source(1, 0);
+
+  fake::Bias bias(0.5);
+  EXPECT_DOUBLE_EQ(bias.apply(1.0, 0.01, source), 1.5);
+
+  // a random walk's variance grows linearly with time
+  const unsigned int walks = 2000;
+  double sum_sq = 0.0;
+  for (unsigned int w = 0; w != walks; ++w) {
+    fake::RandomWalk walk(0.2);
+    double value = 0.0;
+    for (unsigned int i = 0; i != 100; ++i)
+      value = walk.apply(0.0, 0.04, source);
+    sum_sq += value * value;
+  }
+  EXPECT_NEAR(sum_sq / walks, 0.2 * 0.2 * 4.0, 0.01);
+
+  // dropped samples repeat the previous value
+  fake::Dropout dropout(0.3);
+  unsigned int dropped = 0;
+  double last = dropout.apply(-1.0, 0.01, source);
+  EXPECT_DOUBLE_EQ(last, -1.0);
+  for (unsigned int i = 0; i != 10000; ++i) {
+    const double value = dropout.apply(i, 0.01, source);
+    if (value == last)
+      ++dropped;
+    else
+      EXPECT_DOUBLE_EQ(value, i);
+    last = value;
+  }
+  EXPECT_NEAR(dropped / 10000.0, 0.3, 0.02);
+}
+
+/* @brief Test plant noise and sensor noise. */
+TEST(Noise_Plant, should_pass) {
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.45, 0.785,
+                                                    1.0, 1.0);
+  fake::PlantOptions opts(0.45, 0.785);
+  opts.noise_stddev = 0.1;
+  opts.noise_seed = 5;
+
+  // identical plants produce identical noise; other streams don't
+  fake::Plant a(opts, params), b(opts, params);
+  opts.noise_stream = 1;
+  fake::Plant c(opts, params);
+  double speed_a, heading_a, speed_b, heading_b, speed_c, heading_c;
+  for (unsigned int i = 0; i != 100; ++i) {
+    a.command(0.5, 0.1, 0.01);
+    b.command(0.5, 0.1, 0.01);
+    c.command(0.5, 0.1, 0.01);
+  }
+  a.getState(speed_a, heading_a);
+  b.getState(speed_b, heading_b);
+  c.getState(speed_c, heading_c);
+  EXPECT_EQ(speed_a, speed_b);
+  EXPECT_EQ(heading_a, heading_b);
+  EXPECT_NE(speed_a, speed_c);
+
+  // resetting restarts the stream
+  a.reset();
+  b.reset();
+  a.command(0.5, 0.1, 0.01);
+  b.command(0.5, 0.1, 0.01);
+  a.getState(speed_a, heading_a);
+  b.getState(speed_b, heading_b);
+  EXPECT_EQ(speed_a, speed_b);
+
+  // sensor noise only affects measurements
+  opts.noise_stddev = 0.0;
+  fake::Plant d(opts, params);
+  d.addSensorNoise(fake::Plant::Signal::Speed,
+                   std::make_unique<fake::Bias>(0.25));
+  d.command(0.5, 0.0, 0.01);
+  double speed, heading, measured_speed, measured_heading;
+  d.getState(speed, heading);
+  d.getMeasurement(measured_speed, measured_heading);
+  EXPECT_DOUBLE_EQ(speed, 5.0);
+  EXPECT_DOUBLE_EQ(measured_speed, 5.25);
+  EXPECT_DOUBLE_EQ(measured_heading, heading);
+}
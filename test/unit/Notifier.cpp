@@ -0,0 +1,47 @@
+/* @file Notifier.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include <Notifier.hpp>
+
+using ackermann::Clock;
+using ackermann::Notifier;
+
+/* @brief Test that waits time out without a notification. */
+TEST(Notifier_Timeout, should_pass) {
+  Notifier notifier;
+  const uint32_t value = notifier.value();
+  const auto start = Clock::now();
+  EXPECT_FALSE(notifier.wait(value, start + std::chrono::milliseconds(5)));
+  EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(5));
+
+  // a notification since reading the value returns immediately
+  notifier.notify();
+  EXPECT_NE(notifier.value(), value);
+  EXPECT_TRUE(notifier.wait(value, Clock::time_point::max()));
+}
+
+/* @brief Test that every waiting thread is woken up. */
+TEST(Notifier_Wake, should_pass) {
+  Notifier notifier;
+  std::atomic<int> woken {0};
+  const uint32_t value = notifier.value();
+  std::thread waiters[3];
+  for (auto& waiter : waiters)
+    waiter = std::thread([&]() {
+      if (notifier.wait(value, Clock::time_point::max()))
+        ++woken;
+    });
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  EXPECT_EQ(woken, 0);
+  notifier.notify();
+  for (auto& waiter : waiters)
+    waiter.join();
+  EXPECT_EQ(woken, 3);
+}
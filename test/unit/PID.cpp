@@ -73,3 +73,57 @@ TEST(PID_Control3, should_pass) {
   EXPECT_DOUBLE_EQ(pid.getCommand(12.5, 1.0), 1.4);
   EXPECT_DOUBLE_EQ(pid.getCommand(10.0, 1.0), 0.75);
 }
+
+/* @brief Test reporting of the individual PID terms. */
+TEST(PID_Terms, should_pass) {
+  auto params = std::make_shared<PIDParams>(2.0, 1.0, 0.5);
+  PID pid(params);
+
+  double output = pid.getCommand(1.0, 0.1);
+  ackermann::PIDTerms terms = pid.getTerms();
+  EXPECT_DOUBLE_EQ(terms.p, 2.0);
+  EXPECT_DOUBLE_EQ(terms.i, 0.1);
+  EXPECT_DOUBLE_EQ(terms.d, 5.0);
+  EXPECT_DOUBLE_EQ(terms.p + terms.i + terms.d, output);
+
+  pid.reset_PID();
+  terms = pid.getTerms();
+  EXPECT_DOUBLE_EQ(terms.p + terms.i + terms.d, 0.0);
+}
+
+/* @brief Test the anti windup policies, and single precision. */
+TEST(PID_Policies, should_pass) {
+  auto params = std::make_shared<PIDParams>(1.0, 1.0, 0.0);
+
+  // back calculation (the default) removes the excess from the integral
+  PID back(params, -1.0, 1.0);
+  // conditional integration stops integrating while saturated
+  ackermann::BasicPID<double, ackermann::ConditionalIntegration>
+    conditional(params, -1.0, 1.0);
+  // no anti windup keeps integrating
+  ackermann::BasicPID<double, ackermann::NoAntiWindup> none(params, -1.0, 1.0);
+  for (int i = 0; i != 10; ++i) {
+    EXPECT_DOUBLE_EQ(back.getCommand(2.0, 1.0), 1.0);
+    EXPECT_DOUBLE_EQ(conditional.getCommand(2.0, 1.0), 1.0);
+    EXPECT_DOUBLE_EQ(none.getCommand(2.0, 1.0), 1.0);
+  }
+  // (terms are reported before the anti windup is applied)
+  EXPECT_DOUBLE_EQ(back.getTerms().i, 1.0);
+  EXPECT_DOUBLE_EQ(conditional.getTerms().i, 2.0);
+  EXPECT_DOUBLE_EQ(none.getTerms().i, 20.0);
+
+  // recovery once the error reverses
+  EXPECT_DOUBLE_EQ(back.getCommand(-0.5, 1.0), -1.0);
+  EXPECT_DOUBLE_EQ(conditional.getCommand(-0.5, 1.0), -1.0);
+  EXPECT_DOUBLE_EQ(none.getCommand(-0.5, 1.0), 1.0);
+
+  // single precision matches double precision (to within its precision)
+  auto gains = std::make_shared<PIDParams>(0.5, 0.01, 0.125);
+  PID reference(gains);
+  ackermann::BasicPID<float> single(gains);
+  for (int i = 0; i != 100; ++i) {
+    const double error = std::sin(0.1 * i);
+    const float output = single.getCommand(static_cast<float>(error), 0.1f);
+    EXPECT_NEAR(output, reference.getCommand(error, 0.1), 1e-5);
+  }
+}
@@ -0,0 +1,73 @@
+/* @file Params.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <memory>
+#include <thread>
+
+#include <Params.hpp>
+
+using ackermann::Params;
+using ackermann::ParamsSnapshot;
+
+/* @brief Test that snapshots reflect current parameter values. */
+TEST(Params_Snapshot, should_pass) {
+  auto p = std::make_shared<Params>(0.45, 0.5, 0.785, 1.0, 2.0);
+  p->velocity_max = 12.0;
+  p->pid_heading->kd = 0.3;
+
+  ParamsSnapshot s = p->snapshot();
+  EXPECT_DOUBLE_EQ(s.wheel_base, 0.45);
+  EXPECT_DOUBLE_EQ(s.track_width, 0.5);
+  EXPECT_DOUBLE_EQ(s.max_steering_angle, 0.785);
+  EXPECT_DOUBLE_EQ(s.velocity_max, 12.0);
+  EXPECT_DOUBLE_EQ(s.control_frequency, 100.0);
+  EXPECT_DOUBLE_EQ(s.pid_speed.kp, 1.0);
+  EXPECT_DOUBLE_EQ(s.pid_heading.kp, 2.0);
+  EXPECT_DOUBLE_EQ(s.pid_heading.kd, 0.3);
+  EXPECT_EQ(s.version, 0u);
+
+  // updates publish a new version
+  p->update([](Params& params) {
+    params.pid_speed->kp = 3.0;
+    params.pid_speed->ki = 4.0;
+  });
+  s = p->snapshot();
+  EXPECT_DOUBLE_EQ(s.pid_speed.kp, 3.0);
+  EXPECT_DOUBLE_EQ(s.pid_speed.ki, 4.0);
+  EXPECT_EQ(s.version, 1u);
+}
+
+/* @brief Test that snapshots never observe a partial update. */
+TEST(Params_SnapshotConsistency, should_pass) {
+  auto p = std::make_shared<Params>(0.0, 0.45, 0.785, 0.0, 0.0);
+  std::atomic<bool> done {false};
+
+  // continually publish gain sets where every gain is the same
+  std::thread writer([&p, &done]() {
+    for (unsigned int i = 1; i <= 20000; ++i) {
+      p->update([i](Params& params) {
+        params.pid_speed->kp = i;
+        params.pid_speed->ki = i;
+        params.pid_speed->kd = i;
+        params.wheel_base = i;
+      });
+    }
+    done = true;
+  });
+
+  unsigned int torn = 0;
+  while (!done) {
+    ParamsSnapshot s = p->snapshot();
+    if (s.pid_speed.kp != s.pid_speed.ki
+        || s.pid_speed.kp != s.pid_speed.kd
+        || s.pid_speed.kp != s.wheel_base)
+      ++torn;
+  }
+  writer.join();
+
+  EXPECT_EQ(torn, 0u);
+  EXPECT_EQ(p->snapshot().version, 20000u);
+}
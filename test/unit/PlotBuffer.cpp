@@ -0,0 +1,78 @@
+/* @file PlotBuffer.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <vector>
+
+#include <PlotBuffer.hpp>
+
+using ackermann::PlotBuffer;
+
+namespace {
+
+std::vector<double> times(const PlotBuffer& buffer) {
+  std::vector<double> result;
+  buffer.forEach([&result](const double time, double) {
+    result.push_back(time);
+  });
+  return result;
+}
+
+}  // namespace
+
+/* @brief Test that only the most recent samples are kept. */
+TEST(PlotBuffer_Window, should_pass) {
+  PlotBuffer buffer(4, 100);
+  EXPECT_EQ(buffer.decimation(), 1u);
+  EXPECT_EQ(buffer.size(), 0u);
+
+  for (int i = 0; i != 3; ++i)
+    buffer.append(i, 10.0 * i);
+  EXPECT_EQ(times(buffer), std::vector<double>({0, 1, 2}));
+
+  // the oldest samples are overwritten
+  for (int i = 3; i != 10; ++i)
+    buffer.append(i, 10.0 * i);
+  EXPECT_EQ(buffer.size(), 4u);
+  EXPECT_EQ(times(buffer), std::vector<double>({6, 7, 8, 9}));
+
+  double min = 0.0, max = 0.0;
+  buffer.range(min, max);
+  EXPECT_DOUBLE_EQ(min, 0.0);
+  EXPECT_DOUBLE_EQ(max, 90.0);
+
+  buffer.clear();
+  EXPECT_EQ(buffer.size(), 0u);
+}
+
+/* @brief Test min/max decimation of long windows. */
+TEST(PlotBuffer_Decimation, should_pass) {
+  // 100 samples in at most 20 points: buckets of 10 samples
+  PlotBuffer buffer(100, 20);
+  ASSERT_EQ(buffer.decimation(), 10u);
+
+  // a spike within a bucket survives decimation
+  for (int i = 0; i != 1000; ++i)
+    buffer.append(i, i == 955 ? 100.0 : (i == 952 ? -100.0 : 0.0));
+  EXPECT_LE(buffer.size(), 20u);
+
+  std::vector<double> values;
+  buffer.forEach([&values](double, const double value) {
+    values.push_back(value);
+  });
+  ASSERT_EQ(values.size(), 20u);
+  EXPECT_DOUBLE_EQ(values[10], -100.0);
+  EXPECT_DOUBLE_EQ(values[11], 100.0);
+
+  // points are in time order, covering (roughly) the latest 100 samples
+  const std::vector<double> t = times(buffer);
+  EXPECT_GE(t.front(), 900.0);
+  EXPECT_EQ(t.back(), 999.0);
+  for (std::size_t i = 1; i != t.size(); ++i)
+    EXPECT_LE(t[i - 1], t[i]);
+
+  // an incomplete bucket is visible immediately
+  buffer.append(1000, 5.0);
+  EXPECT_EQ(times(buffer).back(), 1000.0);
+}
@@ -0,0 +1,77 @@
+/* @file Realtime.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <cerrno>
+#include <memory>
+#include <thread>
+
+#include <Controller.hpp>
+#include <Realtime.hpp>
+
+using ackermann::RealtimeOptions;
+using ackermann::RealtimeStatus;
+
+/* @brief Test that default options change nothing. */
+TEST(Realtime_Defaults, should_pass) {
+  RealtimeStatus status = ackermann::applyRealtimeOptions(RealtimeOptions());
+  EXPECT_TRUE(status.ok());
+  EXPECT_EQ(status.stack_prefaulted, 0u);
+}
+
+/* @brief Test that individual settings are applied (or fail) independently. */
+TEST(Realtime_Settings, should_pass) {
+  // (apply the options to a thread of our own, so that the pinning doesn't
+  // outlive the test)
+  std::thread thread([]() {
+    // pinning to the first CPU and touching the stack is always permitted
+    RealtimeOptions options;
+    options.cpus = {0};
+    options.prefault_stack = 64 * 1024;
+    RealtimeStatus status = ackermann::applyRealtimeOptions(options);
+    EXPECT_TRUE(status.ok());
+    EXPECT_EQ(status.stack_prefaulted, options.prefault_stack);
+
+    // invalid requests are reported, without affecting the other settings
+    options.policy = RealtimeOptions::Policy::Fifo;
+    options.priority = 1000;
+    options.cpus = {-1};
+    status = ackermann::applyRealtimeOptions(options);
+    EXPECT_FALSE(status.ok());
+    EXPECT_EQ(status.scheduler_error, EINVAL);
+    EXPECT_EQ(status.affinity_error, EINVAL);
+    EXPECT_EQ(status.lock_memory_error, 0);
+    EXPECT_EQ(status.stack_prefaulted, options.prefault_stack);
+  });
+  thread.join();
+}
+
+/* @brief Test that pre-faulting is clamped to the stack. */
+TEST(Realtime_StackLimit, should_pass) {
+  std::thread thread([]() {
+    RealtimeOptions options;
+    options.prefault_stack = std::size_t(1) << 40;
+    const RealtimeStatus status = ackermann::applyRealtimeOptions(options);
+    EXPECT_TRUE(status.ok());
+    EXPECT_GT(status.stack_prefaulted, 0u);
+    EXPECT_LT(status.stack_prefaulted, options.prefault_stack);
+  });
+  thread.join();
+}
+
+/* @brief Test that the controller reports failures and still runs. */
+TEST(Realtime_Controller, should_pass) {
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  ackermann::Controller controller(params);
+
+  RealtimeOptions options;
+  options.policy = RealtimeOptions::Policy::RoundRobin;
+  options.priority = -1;
+  controller.setRealtimeOptions(options);
+  controller.start();
+  EXPECT_TRUE(controller.isRunning());
+  EXPECT_EQ(controller.getRealtimeStatus().scheduler_error, EINVAL);
+  controller.stop(true);
+}
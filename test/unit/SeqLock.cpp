@@ -0,0 +1,83 @@
+/* @file SeqLock.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <SeqLock.hpp>
+
+using ackermann::SeqLock;
+using ackermann::SequenceLock;
+
+namespace {
+
+struct Pair {
+  uint64_t first;
+  uint64_t second;
+};
+
+}  // namespace
+
+/* @brief Test that tryLoad() fails, rather than waits, during a write. */
+TEST(SeqLock_TryLoad, should_pass) {
+  SeqLock<Pair> lock({1, 1});
+  Pair value {0, 0};
+  EXPECT_TRUE(lock.tryLoad(value));
+  EXPECT_EQ(value.first, 1u);
+
+  lock.modify([&](Pair& pair) {
+    pair = {2, 2};
+    Pair during {0, 0};
+    EXPECT_FALSE(lock.tryLoad(during, 8));
+    EXPECT_EQ(during.first, 0u);
+  });
+  EXPECT_TRUE(lock.tryLoad(value));
+  EXPECT_EQ(value.second, 2u);
+  EXPECT_EQ(lock.version(), 2u);
+}
+
+/* @brief Test that a contended lock sleeps, letting the holder finish. */
+TEST(SeqLock_Contended, should_pass) {
+  SequenceLock lock;
+  std::atomic<bool> held {false};
+  std::thread holder([&]() {
+    std::lock_guard<SequenceLock> guard(lock);
+    held = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  });
+  while (!held)
+    std::this_thread::yield();
+
+  uint64_t start;
+  EXPECT_FALSE(lock.tryReadBegin(start));
+  lock.lock();
+  lock.unlock();
+  holder.join();
+  EXPECT_TRUE(lock.tryReadBegin(start));
+  EXPECT_EQ(lock.version(), 2u);
+}
+
+/* @brief Test that readers never see a torn single writer value. */
+TEST(SeqLock_SingleWriter, should_pass) {
+  SeqLock<Pair, true> lock({0, ~uint64_t(0)});
+  const uint64_t count = 100000;
+  std::thread writer([&]() {
+    for (uint64_t i = 1; i <= count; ++i)
+      lock.store({i, ~i});
+  });
+
+  uint64_t last = 0;
+  while (last != count) {
+    Pair value;
+    if (!lock.tryLoad(value))
+      value = lock.load();
+    ASSERT_EQ(value.second, ~value.first);
+    ASSERT_GE(value.first, last);
+    last = value.first;
+  }
+  writer.join();
+}
@@ -0,0 +1,151 @@
+/* @file SharedMemory.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <Controller.hpp>
+#include <SharedMemory.hpp>
+
+using ackermann::Clock;
+using ackermann::CommandSample;
+using ackermann::SharedClient;
+using ackermann::SharedServer;
+
+namespace {
+
+std::string segmentName(const std::string& test) {
+  return "/ackermann-" + test + "-" + std::to_string(::getpid());
+}
+
+}  // namespace
+
+/* @brief Test exchanging inputs and outputs with a client process. */
+TEST(SharedMemory_TwoProcesses, should_pass) {
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  ackermann::Controller controller(params);
+  const std::string name = segmentName("processes");
+  SharedServer server(controller, name);
+
+  // (fork before starting the control thread)
+  const pid_t child = ::fork();
+  ASSERT_GE(child, 0);
+  if (!child) {
+    // client process: set a goal, then feed back states for every command
+    int status = 0;
+    try {
+      SharedClient client(name);
+      if (!client.setGoal({1.0, 0.5, Clock::now()})
+          || client.setState({0.0, INFINITY, Clock::now()}))
+        ::_exit(1);
+      CommandSample command;
+      for (int i = 0; i != 50; ++i) {
+        if (!client.waitForCommand(command.sequence, command,
+                                   std::chrono::seconds(1)))
+          ::_exit(2);
+        client.setState({0.25, 0.125, Clock::now()});
+      }
+      status = command.throttle > 0.0 ? 0 : 3;
+    } catch (const std::exception&) {
+      status = 4;
+    }
+    ::_exit(status);
+  }
+
+  controller.start();
+  int status = -1;
+  ASSERT_EQ(::waitpid(child, &status, 0), child);
+  controller.stop(true);
+  ASSERT_TRUE(WIFEXITED(status));
+  EXPECT_EQ(WEXITSTATUS(status), 0);
+
+  // the client's inputs reached the controller
+  double speed, heading;
+  controller.getGoal(speed, heading);
+  EXPECT_EQ(speed, 1.0);
+  EXPECT_EQ(heading, 0.5);
+  EXPECT_GE(controller.getTimingStats().iterations, 50u);
+
+  // and its outputs are visible to (local) clients too
+  SharedClient client(name);
+  CommandSample shared, latest;
+  client.getCommand(shared);
+  controller.getCommand(latest);
+  EXPECT_EQ(shared.sequence, latest.sequence);
+  EXPECT_EQ(shared.throttle, latest.throttle);
+  EXPECT_FALSE(client.waitForCommand(shared.sequence, shared,
+                                     std::chrono::milliseconds(10)));
+}
+
+/* @brief Test that a client stalled mid-write doesn't stall the loop. */
+TEST(SharedMemory_StalledClient, should_pass) {
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  ackermann::Controller controller(params);
+  const std::string name = segmentName("stalled");
+  SharedServer server(controller, name);
+
+  // map the segment directly, to hold its write lock
+  const int fd = ::shm_open(name.c_str(), O_RDWR, 0);
+  ASSERT_GE(fd, 0);
+  void* mapping = ::mmap(nullptr, sizeof(ackermann::SharedBlock),
+                         PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  ::close(fd);
+  ASSERT_NE(mapping, MAP_FAILED);
+  auto block = static_cast<ackermann::SharedBlock*>(mapping);
+
+  // a goal is published, then a second write stalls before completing
+  block->goal.store({1.0, 0.5, Clock::now()});
+  double speed, heading;
+  block->goal.modify([&](ackermann::GoalSample& goal) {
+    goal = {2.0, 0.25, Clock::now()};
+    controller.step(0.01);
+    controller.step(0.01);
+    controller.getGoal(speed, heading);
+  });
+  EXPECT_EQ(speed, 0.0);
+  EXPECT_EQ(server.missedReads(), 2u);
+
+  // once the write completes, its value is passed on
+  controller.step(0.01);
+  controller.getGoal(speed, heading);
+  EXPECT_EQ(speed, 2.0);
+  EXPECT_EQ(heading, 0.25);
+  EXPECT_EQ(server.missedReads(), 2u);
+  ::munmap(mapping, sizeof(ackermann::SharedBlock));
+}
+
+/* @brief Test that missing and incompatible segments are rejected. */
+TEST(SharedMemory_Incompatible, should_pass) {
+  const std::string name = segmentName("incompatible");
+  EXPECT_THROW(SharedClient client(name), std::system_error);
+
+  const int fd = ::shm_open(name.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0600);
+  ASSERT_GE(fd, 0);
+  ASSERT_EQ(::ftruncate(fd, sizeof(ackermann::SharedBlock)), 0);
+  ::close(fd);
+  EXPECT_THROW(SharedClient client(name), std::runtime_error);
+  ::shm_unlink(name.c_str());
+
+  // the segment is removed along with its server
+  {
+    auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                      1.0, 1.0);
+    ackermann::Controller controller(params);
+    SharedServer server(controller, name);
+    SharedClient client(name);
+  }
+  EXPECT_THROW(SharedClient client(name), std::system_error);
+}
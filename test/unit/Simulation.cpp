@@ -0,0 +1,105 @@
+/* @file Simulation.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+#include <vector>
+
+#include <Simulation.hpp>
+
+namespace {
+
+ackermann::Scenario parse(const std::string& text) {
+  std::istringstream in(text);
+  return ackermann::parseScenario(in);
+}
+
+std::vector<ackermann::SimulationSample> run(
+    const ackermann::Scenario& scenario) {
+  std::vector<ackermann::SimulationSample> samples;
+  ackermann::simulate(scenario,
+                      [&samples](const ackermann::SimulationSample& s) {
+                        samples.push_back(s);
+                      });
+  return samples;
+}
+
+}  // namespace
+
+/* @brief Test reading scenarios. */
+TEST(Simulation_Parse, should_pass) {
+  const ackermann::Scenario scenario = parse(
+    "# comment\n"
+    "duration 2.5\n"
+    "\n"
+    "dt 0.02   # trailing comment\n"
+    "speed_gains 1 0.5 0.1\n"
+    "setpoint 0 3 1.2\n"
+    "setpoint 1 2 -1\n"
+    "lag 0.1 0.2\n"
+    "sensor heading white 0 0.01\n"
+    "sensor speed dropout 0.5\n");
+  EXPECT_DOUBLE_EQ(scenario.duration, 2.5);
+  EXPECT_DOUBLE_EQ(scenario.dt, 0.02);
+  EXPECT_DOUBLE_EQ(scenario.pid_speed.ki, 0.5);
+  ASSERT_EQ(scenario.setpoints.size(), 2u);
+  EXPECT_DOUBLE_EQ(scenario.setpoints[1].heading, -1.0);
+  EXPECT_DOUBLE_EQ(scenario.steering_lag, 0.2);
+  ASSERT_EQ(scenario.sensors.size(), 2u);
+  EXPECT_TRUE(scenario.sensors[0].heading);
+  EXPECT_DOUBLE_EQ(scenario.sensors[0].b, 0.01);
+  EXPECT_EQ(scenario.sensors[1].model,
+            ackermann::SensorNoise::Model::Dropout);
+
+  // errors name the offending line
+  for (const char* bad : {"duration\n", "dt -1\n", "\nbogus 1\n",
+                          "setpoint 2 1 1\nsetpoint 1 1 1\n",
+                          "sensor wheel bias 1\n", "duration 1 2\n"}) {
+    EXPECT_THROW(parse(bad), std::runtime_error) << bad;
+  }
+  try {
+    parse("duration 1\n\nvehicle 1 x 1\n");
+    FAIL();
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("line 3"), std::string::npos);
+  }
+}
+
+/* @brief Test running a scenario with a setpoint schedule. */
+TEST(Simulation_Run, should_pass) {
+  ackermann::Scenario scenario = parse(
+    "duration 20\n"
+    "speed_gains 1 0.1 0\n"
+    "heading_gains 2 0 0.02\n"
+    "setpoint 0 3 1.2\n"
+    "setpoint 10 1 -0.5\n"
+    "lag 0.1 0.05\n"
+    "substeps 2\n");
+  const std::vector<ackermann::SimulationSample> samples = run(scenario);
+  ASSERT_EQ(samples.size(), 2000u);
+  EXPECT_EQ(samples.back().tick, 1999u);
+  EXPECT_NEAR(samples.back().time, 20.0, 1e-9);
+
+  // both setpoints are reached
+  const ackermann::SimulationSample& first = samples[999];
+  EXPECT_DOUBLE_EQ(first.goal_speed, 3.0);
+  EXPECT_NEAR(first.speed, 3.0, 0.05);
+  EXPECT_NEAR(first.heading, 1.2, 0.05);
+  const ackermann::SimulationSample& last = samples.back();
+  EXPECT_DOUBLE_EQ(last.goal_heading, -0.5);
+  EXPECT_NEAR(last.speed, 1.0, 0.05);
+  EXPECT_NEAR(last.heading, -0.5, 0.05);
+
+  // noisy runs are reproducible
+  scenario.noise_stddev = 0.01;
+  scenario.sensors.push_back({false, ackermann::SensorNoise::Model::White,
+                              0.0, 0.05});
+  const std::vector<ackermann::SimulationSample> a = run(scenario);
+  const std::vector<ackermann::SimulationSample> b = run(scenario);
+  EXPECT_EQ(a.back().speed, b.back().speed);
+  EXPECT_EQ(a.back().measured_speed, b.back().measured_speed);
+  EXPECT_NE(a.back().measured_speed, a.back().speed);
+}
@@ -0,0 +1,89 @@
+/* @file SpscRing.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <SpscRing.hpp>
+
+using ackermann::SpscRing;
+
+/* @brief Test single threaded FIFO semantics. */
+TEST(SpscRing_Basic, should_pass) {
+  SpscRing<int, 4> ring;
+  int value;
+  EXPECT_FALSE(ring.pop(value));
+  EXPECT_EQ(ring.size(), 0u);
+
+  // fill, then overflow
+  for (int i = 0; i != 4; ++i)
+    EXPECT_TRUE(ring.push(i));
+  EXPECT_FALSE(ring.push(4));
+  EXPECT_EQ(ring.size(), 4u);
+  EXPECT_EQ(ring.dropped(), 1u);
+
+  // values come out in order, across the wrap around
+  EXPECT_TRUE(ring.pop(value));
+  EXPECT_EQ(value, 0);
+  EXPECT_TRUE(ring.push(5));
+  int out[8];
+  EXPECT_EQ(ring.drain(out, 2), 2u);
+  EXPECT_EQ(out[0], 1);
+  EXPECT_EQ(out[1], 2);
+  EXPECT_EQ(ring.drain(out), 2u);
+  EXPECT_EQ(out[0], 3);
+  EXPECT_EQ(out[1], 5);
+  EXPECT_EQ(ring.drain(out), 0u);
+}
+
+/* @brief Test a capacity given at construction. */
+TEST(SpscRing_Dynamic, should_pass) {
+  SpscRing<int> ring(2);
+  EXPECT_EQ(ring.capacity(), 2u);
+  EXPECT_TRUE(ring.push(1));
+  EXPECT_TRUE(ring.push(2));
+  EXPECT_FALSE(ring.push(3));
+  int out[2];
+  EXPECT_EQ(ring.drain(out), 2u);
+  EXPECT_EQ(out[1], 2);
+
+  // an empty ring is always full
+  SpscRing<int> empty(0);
+  EXPECT_EQ(empty.capacity(), 0u);
+  EXPECT_FALSE(empty.push(1));
+  EXPECT_EQ(empty.drain(out), 0u);
+  EXPECT_THROW(SpscRing<int>(3), std::invalid_argument);
+}
+
+/* @brief Test that a concurrent consumer sees every value, in order. */
+TEST(SpscRing_Concurrent, should_pass) {
+  const uint64_t total = 200000;
+  SpscRing<uint64_t, 64> ring;
+
+  std::thread producer([&ring, total]() {
+    for (uint64_t i = 0; i != total;)
+      if (ring.push(i))
+        ++i;
+      else
+        std::this_thread::yield();
+  });
+
+  std::vector<uint64_t> buffer(16);
+  uint64_t expected = 0;
+  bool ordered = true;
+  while (expected != total) {
+    const std::size_t count = ring.drain(buffer.begin(), buffer.size());
+    for (std::size_t i = 0; i != count; ++i)
+      ordered &= (buffer[i] == expected++);
+    if (!count)
+      std::this_thread::yield();
+  }
+  producer.join();
+
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(ring.size(), 0u);
+}
@@ -0,0 +1,103 @@
+/* @file StageProfiler.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <Controller.hpp>
+#include <StageProfiler.hpp>
+
+using ackermann::Stage;
+using ackermann::StageProfiler;
+using ackermann::StageStats;
+using ackermann::StageTrace;
+
+/* @brief Test per-stage statistics and timelines. */
+TEST(StageProfiler_Record, should_pass) {
+  StageProfiler profiler;
+  EXPECT_EQ(profiler.stats(Stage::PID).count, 0u);
+
+  for (uint64_t tick = 0; tick != 3; ++tick) {
+    profiler.begin(tick);
+    for (std::size_t s = 0; s != StageProfiler::kStages; ++s) {
+      // (only the model stage takes measurable time)
+      if (static_cast<Stage>(s) == Stage::Model)
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      profiler.mark(static_cast<Stage>(s));
+    }
+    profiler.end();
+  }
+
+  const StageStats model = profiler.stats(Stage::Model);
+  EXPECT_EQ(model.count, 3u);
+  EXPECT_GE(model.min, 1000000u);
+  EXPECT_GE(model.max, model.min);
+  EXPECT_GE(model.mean, model.min);
+  EXPECT_LE(model.mean, model.max);
+  EXPECT_GE(model.durations.percentile(0.5), model.min);
+  EXPECT_LT(profiler.stats(Stage::Inputs).max, model.min);
+
+  // timelines are cumulative, in stage order
+  StageTrace traces[4];
+  ASSERT_EQ(profiler.drainTrace(traces, 4), 3u);
+  for (uint64_t tick = 0; tick != 3; ++tick) {
+    EXPECT_EQ(traces[tick].tick, tick);
+    for (std::size_t s = 1; s != StageProfiler::kStages; ++s)
+      EXPECT_GE(traces[tick].end[s], traces[tick].end[s - 1]);
+    EXPECT_GE(traces[tick].end[StageProfiler::kStages - 1], 1000000u);
+  }
+  EXPECT_EQ(profiler.traceDropped(), 0u);
+
+  // a summary line per stage
+  std::ostringstream summary;
+  summary << profiler;
+  EXPECT_NE(summary.str().find("model: 3 samples"), std::string::npos);
+
+  profiler.reset();
+  EXPECT_EQ(profiler.stats(Stage::Model).count, 0u);
+}
+
+/* @brief Test Chrome trace-event export. */
+TEST(StageProfiler_ChromeTrace, should_pass) {
+  StageTrace trace;
+  trace.tick = 7;
+  trace.start = std::chrono::steady_clock::time_point(
+    std::chrono::microseconds(1000));
+  for (std::size_t s = 0; s != StageProfiler::kStages; ++s)
+    trace.end[s] = 1000 * (s + 1);
+
+  std::ostringstream out;
+  ackermann::writeChromeTrace(out, &trace, 1);
+  const std::string json = out.str();
+  EXPECT_EQ(json.find("{\"displayTimeUnit\":\"ns\",\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find("{\"name\":\"tick\",\"cat\":\"controller\",\"ph\":\"X\","
+                      "\"pid\":1,\"tid\":1,\"ts\":1000,\"dur\":6,"
+                      "\"args\":{\"tick\":7}}"), std::string::npos);
+  EXPECT_NE(json.find("\"name\":\"limits\",\"cat\":\"controller\",\"ph\":\"X\","
+                      "\"pid\":1,\"tid\":1,\"ts\":1002,\"dur\":1"),
+            std::string::npos);
+  EXPECT_EQ(json.substr(json.size() - 4), "\n]}\n");
+}
+
+#ifdef ACKERMANN_PROFILE_STAGES
+/* @brief Test that the controller profiles every stage of every iteration. */
+TEST(StageProfiler_Controller, should_pass) {
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  ackermann::Controller controller(params);
+  for (int i = 0; i != 10; ++i)
+    controller.step(0.01);
+
+  StageProfiler& profiler = controller.getStageProfiler();
+  for (std::size_t s = 0; s != StageProfiler::kStages; ++s)
+    EXPECT_EQ(profiler.stats(static_cast<Stage>(s)).count, 10u);
+  StageTrace traces[16];
+  EXPECT_EQ(profiler.drainTrace(traces, 16), 10u);
+  EXPECT_EQ(traces[9].tick, 9u);
+}
+#endif
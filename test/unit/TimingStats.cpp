@@ -0,0 +1,114 @@
+/* @file TimingStats.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <sstream>
+#include <thread>
+
+#include <Controller.hpp>
+#include <TimingStats.hpp>
+
+using ackermann::Histogram;
+using ackermann::TimingRecorder;
+using ackermann::TimingStats;
+
+/* @brief Test histogram bucketing precision over the full value range. */
+TEST(TimingStats_HistogramBuckets, should_pass) {
+  // small values are exact
+  for (uint64_t v = 0; v != Histogram::kSubBuckets; ++v)
+    EXPECT_EQ(Histogram::bucketValue(Histogram::bucket(v)), v);
+
+  // larger values are reproduced to within 1 / kSubBuckets
+  for (uint64_t v = 17; v < (uint64_t(1) << 62); v = v * 3 + 1) {
+    const uint64_t approx = Histogram::bucketValue(Histogram::bucket(v));
+    EXPECT_GE(approx, v);
+    EXPECT_LE(approx - v, v / Histogram::kSubBuckets);
+  }
+
+  // and the extremes are representable
+  const uint64_t max = std::numeric_limits<uint64_t>::max();
+  EXPECT_EQ(Histogram::bucket(max), Histogram::kBuckets - 1);
+  EXPECT_EQ(Histogram::bucketValue(Histogram::kBuckets - 1), max);
+}
+
+/* @brief Test histogram statistics. */
+TEST(TimingStats_HistogramPercentiles, should_pass) {
+  Histogram histogram;
+  EXPECT_EQ(histogram.snapshot().count(), 0u);
+  EXPECT_EQ(histogram.snapshot().percentile(0.5), 0u);
+
+  for (uint64_t v = 1; v <= 1000; ++v)
+    histogram.record(v * 1000);
+
+  Histogram::Snapshot s = histogram.snapshot();
+  EXPECT_EQ(s.count(), 1000u);
+  EXPECT_NEAR(s.percentile(0.5), 500000, 500000 / 16);
+  EXPECT_NEAR(s.percentile(0.99), 990000, 990000 / 16);
+  EXPECT_NEAR(s.max(), 1000000, 1000000 / 16);
+  EXPECT_NEAR(s.mean(), 500500, 500500 / 16);
+
+  histogram.reset();
+  EXPECT_EQ(histogram.snapshot().count(), 0u);
+}
+
+/* @brief Test accumulation of loop statistics. */
+TEST(TimingStats_Recorder, should_pass) {
+  TimingRecorder recorder;
+  recorder.record(0, 100, 0, false, 0);
+  recorder.record(10000, 200, 50, false, 0);
+  recorder.record(10000, 30000, 10, true, 2);
+
+  TimingStats stats = recorder.stats();
+  EXPECT_EQ(stats.iterations, 3u);
+  EXPECT_EQ(stats.overruns, 1u);
+  EXPECT_EQ(stats.missed_ticks, 2u);
+  EXPECT_EQ(stats.max_lateness, 50u);
+  // the first iteration has no period
+  EXPECT_EQ(stats.period.count(), 2u);
+  EXPECT_EQ(stats.compute.count(), 3u);
+
+  recorder.reset();
+  stats = recorder.stats();
+  EXPECT_EQ(stats.iterations, 0u);
+  EXPECT_EQ(stats.overruns, 0u);
+}
+
+/* @brief Test that the logger only reports new problems. */
+TEST(TimingStats_Logger, should_pass) {
+  TimingRecorder recorder;
+  std::ostringstream out;
+  {
+    ackermann::TimingLogger logger([&recorder](){return recorder.stats();},
+                                   out, std::chrono::milliseconds(5));
+    recorder.record(0, 100, 0, false, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_TRUE(out.str().empty());
+    recorder.record(10000, 30000, 10, true, 0);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  }
+  EXPECT_NE(out.str().find("1 overruns"), std::string::npos);
+}
+
+/* @brief Test that the control loop records its timing. */
+TEST(TimingStats_Controller, should_pass) {
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  params->control_frequency = 100.0;
+  ackermann::Controller controller(params);
+
+  controller.start();
+  std::this_thread::sleep_for(std::chrono::milliseconds(300));
+  controller.stop(true);
+
+  const TimingStats stats = controller.getTimingStats();
+  EXPECT_GT(stats.iterations, 10u);
+  EXPECT_EQ(stats.compute.count(), stats.iterations);
+  EXPECT_EQ(stats.period.count() + 1, stats.iterations);
+  // the median period should be close to nominal (10ms)
+  EXPECT_NEAR(stats.period.percentile(0.5), 10000000, 2000000);
+}
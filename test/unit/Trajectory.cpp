@@ -0,0 +1,164 @@
+/* @file Trajectory.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <thread>
+
+#include <Controller.hpp>
+#include <Trajectory.hpp>
+
+using ackermann::Clock;
+using ackermann::GoalSample;
+using ackermann::Trajectory;
+using ackermann::TrajectorySetpoint;
+using std::chrono::milliseconds;
+
+namespace {
+
+const Clock::time_point t0 = Clock::time_point() + std::chrono::hours(1);
+
+}  // namespace
+
+/* @brief Test interpolation between knots, and holding the final knot. */
+TEST(Trajectory_Interpolate, should_pass) {
+  Trajectory trajectory;
+  TrajectorySetpoint setpoint;
+  EXPECT_FALSE(trajectory.sample(t0, setpoint));
+
+  // (heading crosses +/-pi along the shortest arc)
+  const GoalSample knots[] = {{1.0, 3.0, t0},
+                              {2.0, -3.0, t0 + milliseconds(1000)},
+                              {2.0, -3.0, t0 + milliseconds(2000)}};
+  EXPECT_EQ(trajectory.append(knots, 3), 3u);
+  EXPECT_EQ(trajectory.pending(), 3u);
+
+  // not started yet
+  EXPECT_FALSE(trajectory.sample(t0 - milliseconds(1), setpoint));
+
+  EXPECT_TRUE(trajectory.sample(t0 + milliseconds(250), setpoint));
+  const double turn = 2 * M_PI - 6.0;
+  EXPECT_NEAR(setpoint.goal.speed, 1.25, 1e-9);
+  EXPECT_NEAR(setpoint.goal.heading, 3.0 + 0.25 * turn, 1e-9);
+  EXPECT_NEAR(setpoint.speed_rate, 1.0, 1e-9);
+  EXPECT_NEAR(setpoint.heading_rate, turn, 1e-9);
+  EXPECT_EQ(setpoint.goal.stamp, t0 + milliseconds(250));
+
+  EXPECT_TRUE(trajectory.sample(t0 + milliseconds(1500), setpoint));
+  EXPECT_NEAR(setpoint.goal.speed, 2.0, 1e-9);
+  EXPECT_NEAR(setpoint.goal.heading, -3.0, 1e-9);
+  EXPECT_EQ(setpoint.speed_rate, 0.0);
+
+  // past the end, the final knot is held
+  EXPECT_TRUE(trajectory.sample(t0 + milliseconds(2500), setpoint));
+  EXPECT_NEAR(setpoint.goal.speed, 2.0, 1e-9);
+  EXPECT_EQ(setpoint.speed_rate, 0.0);
+  EXPECT_EQ(setpoint.heading_rate, 0.0);
+
+  // and is interpolated from once more knots are appended
+  EXPECT_TRUE(trajectory.append({3.0, -3.0, t0 + milliseconds(4000)}));
+  EXPECT_TRUE(trajectory.sample(t0 + milliseconds(3000), setpoint));
+  EXPECT_NEAR(setpoint.goal.speed, 2.5, 1e-9);
+  EXPECT_NEAR(setpoint.speed_rate, 0.5, 1e-9);
+}
+
+/* @brief Test that invalid knots are rejected. */
+TEST(Trajectory_Reject, should_pass) {
+  Trajectory trajectory;
+  EXPECT_TRUE(trajectory.append({1.0, 0.0, t0}));
+  // not later than the previous knot
+  EXPECT_FALSE(trajectory.append({1.0, 0.0, t0}));
+  // not finite
+  const double nan = std::numeric_limits<double>::quiet_NaN();
+  EXPECT_FALSE(trajectory.append({nan, 0.0, t0 + milliseconds(1)}));
+  EXPECT_FALSE(trajectory.append({1.0, INFINITY, t0 + milliseconds(1)}));
+  EXPECT_EQ(trajectory.pending(), 1u);
+
+  // full
+  std::size_t appended = 1;
+  while (trajectory.append({1.0, 0.0, t0 + milliseconds(appended)}))
+    ++appended;
+  EXPECT_EQ(appended, Trajectory::kCapacity);
+}
+
+/* @brief Test that clearing discards both pending and consumed knots. */
+TEST(Trajectory_Clear, should_pass) {
+  Trajectory trajectory;
+  TrajectorySetpoint setpoint;
+  trajectory.append({1.0, 0.0, t0});
+  trajectory.append({2.0, 0.0, t0 + milliseconds(1000)});
+  EXPECT_TRUE(trajectory.sample(t0 + milliseconds(500), setpoint));
+
+  trajectory.clear();
+  EXPECT_FALSE(trajectory.sample(t0 + milliseconds(600), setpoint));
+
+  // a new trajectory may start at any time, even before the previous one
+  trajectory.append({3.0, 0.0, t0});
+  trajectory.append({3.0, 0.0, t0 + milliseconds(1000)});
+  trajectory.clear();
+  trajectory.append({4.0, 0.0, t0});
+  trajectory.append({4.0, 0.0, t0 + milliseconds(1000)});
+  EXPECT_TRUE(trajectory.sample(t0 + milliseconds(700), setpoint));
+  EXPECT_NEAR(setpoint.goal.speed, 4.0, 1e-9);
+}
+
+/* @brief Test appending concurrently with sampling. */
+TEST(Trajectory_Concurrent, should_pass) {
+  Trajectory trajectory;
+  const int knots = 20000;
+  std::thread producer([&](){
+    for (int i = 0; i != knots; ++i)
+      while (!trajectory.append({1.0 * i, 0.0, t0 + milliseconds(i)}))
+        std::this_thread::yield();
+  });
+
+  // speed equals the elapsed time (ms) throughout, once the producer has
+  // caught up (until then, the latest knot is held)
+  TrajectorySetpoint setpoint;
+  for (int i = 0; i < knots - 1;) {
+    const auto now = t0 + std::chrono::microseconds(i * 1000 + 500);
+    if (!trajectory.sample(now, setpoint) || !setpoint.speed_rate) {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_NEAR(setpoint.goal.speed, i + 0.5, 1e-6);
+    ++i;
+  }
+  producer.join();
+}
+
+/* @brief Test that a controller follows its trajectory, with and without
+ * feed-forward. */
+TEST(Trajectory_Controller, should_pass) {
+  auto params = std::make_shared<ackermann::Params>(0.45, 0.5, 0.785,
+                                                    1.0, 1.0);
+  double errors[2];
+  for (const bool feed_forward : {false, true}) {
+    ackermann::Controller controller(params);
+    controller.setFeedForward(feed_forward);
+
+    // accelerate and turn at a constant rate
+    for (int i = 0; i <= 10; ++i)
+      ASSERT_TRUE(controller.appendTrajectory(
+        {0.5 + 0.1 * i, 0.2 * i, t0 + milliseconds(1000 * i)}));
+
+    double error = 0.0;
+    for (int i = 0; i != 1000; ++i) {
+      const Clock::time_point now = t0 + milliseconds(10 * i);
+      controller.step(0.01, now);
+      double speed, heading, goal_speed, goal_heading;
+      controller.getState(speed, heading);
+      controller.getGoal(goal_speed, goal_heading);
+      EXPECT_NEAR(goal_speed, 0.5 + 0.001 * i, 1e-9);
+      if (i >= 200)
+        error += std::abs(goal_heading - heading);
+    }
+    errors[feed_forward] = error;
+  }
+  // feed-forward reduces the (steady state) heading lag
+  EXPECT_LT(errors[1], 0.5 * errors[0]);
+}
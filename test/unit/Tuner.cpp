@@ -0,0 +1,73 @@
+/* @file Tuner.cpp
+ * @copyright [2020]
+ */
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include <Params.hpp>
+#include <Tuner.hpp>
+
+/**
+* @brief Test Fixture for tuning the gains of a small vehicle.
+*/
+class AckermannTunerTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    params_ = std::make_shared<ackermann::Params>(0.45, 0.45, 0.785,
+                                                  0.02, 0.2);
+    options_.starts = 4;
+    options_.evaluations = 60;
+  }
+
+  std::shared_ptr<ackermann::Params> params_;
+  ackermann::TuningOptions options_;
+};
+
+/* @brief Test scoring of a simple step response. */
+TEST_F(AckermannTunerTest, Tuner_Evaluate) {
+  // a speed step; the fake plant follows the throttle exactly
+  options_.scenarios = {{0.0, 0.0, 5.0, 0.0, 5.0}};
+  const ackermann::TuningScore score = ackermann::evaluate(
+    params_->snapshot(), options_);
+  EXPECT_TRUE(std::isfinite(score.cost));
+  EXPECT_GT(score.error, 0.0);
+  EXPECT_GT(score.settling_time, 0.0);
+  EXPECT_LE(score.settling_time, 5.0);
+  EXPECT_DOUBLE_EQ(score.cost, score.settling_time
+                   + 2.0 * score.overshoot + score.error);
+
+  // the same gains always score the same
+  EXPECT_DOUBLE_EQ(ackermann::evaluate(params_->snapshot(), options_).cost,
+                   score.cost);
+
+  // a higher gain responds faster
+  params_->pid_speed->kp = 0.2;
+  EXPECT_LT(ackermann::evaluate(params_->snapshot(), options_).error,
+            score.error);
+}
+
+/* @brief Test that tuning improves upon (and is independent of threads) */
+TEST_F(AckermannTunerTest, Tuner_Tune) {
+  const ackermann::ParamsSnapshot initial = params_->snapshot();
+  const double initial_cost = ackermann::evaluate(initial, options_).cost;
+
+  options_.threads = 1;
+  const ackermann::TuningResult serial = ackermann::tune(initial, options_);
+  EXPECT_LT(serial.score.cost, initial_cost);
+  EXPECT_GE(serial.evaluations, options_.starts);
+  EXPECT_LE(serial.evaluations,
+            options_.starts * (options_.evaluations + 8));
+  for (double gain : {serial.pid_speed.kp, serial.pid_speed.ki,
+                      serial.pid_speed.kd, serial.pid_heading.kp,
+                      serial.pid_heading.ki, serial.pid_heading.kd})
+    EXPECT_GE(gain, 0.0);
+
+  options_.threads = 3;
+  const ackermann::TuningResult parallel = ackermann::tune(initial, options_);
+  EXPECT_DOUBLE_EQ(parallel.score.cost, serial.score.cost);
+  EXPECT_DOUBLE_EQ(parallel.pid_speed.kp, serial.pid_speed.kp);
+  EXPECT_DOUBLE_EQ(parallel.pid_heading.kp, serial.pid_heading.kp);
+  EXPECT_EQ(parallel.evaluations, serial.evaluations);
+}